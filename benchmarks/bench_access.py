@@ -0,0 +1,57 @@
+"""Per-key access cost on field files of increasing size."""
+
+import tempfile
+import timeit
+from pathlib import Path
+
+from foamlib import FoamFieldFile
+
+SIZES = [10**3, 10**4, 10**5]
+NUMBER = 100
+
+
+def write_field(path: Path, size: int) -> None:
+    path.write_text(
+        "FoamFile\n{\n    version 2.0;\n    format ascii;\n    class volScalarField;\n}\n"
+        "dimensions [0 2 -2 0 0 0 0];\n"
+        f"internalField nonuniform List<scalar> {size}(\n"
+        + "\n".join(str(float(i)) for i in range(size))
+        + "\n);\n"
+        "boundaryField\n{\n"
+        "    inlet\n    {\n        type zeroGradient;\n    }\n"
+        "    outlet\n    {\n        type fixedValue;\n        value uniform 0;\n    }\n"
+        "}\n"
+    )
+
+
+def main() -> None:
+    with tempfile.TemporaryDirectory() as tmp:
+        print(
+            f"{'cells':>10} {'type [us]':>12} {'dimensions [us]':>16}"
+            f" {'type, no with [us]':>20}"
+        )
+        for size in SIZES:
+            path = Path(tmp) / f"p{size}"
+            write_field(path, size)
+
+            f = FoamFieldFile(path)
+            with f:
+                t_type = timeit.timeit(
+                    lambda: f["boundaryField", "inlet", "type"],
+                    number=NUMBER,
+                )
+                t_dims = timeit.timeit(lambda: f["dimensions"], number=NUMBER)
+
+            t_stat = timeit.timeit(
+                lambda: f["boundaryField", "inlet", "type"],
+                number=NUMBER,
+            )
+
+            print(
+                f"{size:>10} {t_type / NUMBER * 1e6:>12.1f}"
+                f" {t_dims / NUMBER * 1e6:>16.1f} {t_stat / NUMBER * 1e6:>20.1f}"
+            )
+
+
+if __name__ == "__main__":
+    main()
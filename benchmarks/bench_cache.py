@@ -0,0 +1,52 @@
+"""Time to open a field file without the on-disk parse cache, and with it once populated."""
+
+import os
+import tempfile
+import time
+from pathlib import Path
+
+from foamlib import FoamFieldFile
+
+SIZES = [10**4, 10**5, 10**6]
+
+
+def write_field(path: Path, size: int) -> None:
+    path.write_text(
+        "FoamFile\n{\n    version 2.0;\n    format ascii;\n    class volVectorField;\n}\n"
+        "dimensions [0 1 -1 0 0 0 0];\n"
+        f"internalField nonuniform List<vector> {size}(\n"
+        + "\n".join(f"({i}.5 {i}.25 -{i}.125)" for i in range(size))
+        + "\n);\n"
+        "boundaryField\n{\n    wall\n    {\n        type noSlip;\n    }\n}\n"
+    )
+
+
+def open_field(path: Path) -> float:
+    start = time.perf_counter()
+    FoamFieldFile(path).internal_field
+    return time.perf_counter() - start
+
+
+def main() -> None:
+    with tempfile.TemporaryDirectory() as tmp:
+        print(f"{'cells':>10} {'parse [ms]':>11} {'cached [ms]':>12}")
+        for size in SIZES:
+            path = Path(tmp) / f"U{size}"
+            write_field(path, size)
+            # Files modified in the last 2 s are never cached, as a later
+            # change may not alter their timestamp; backdate it
+            mtime = time.time() - 10
+            os.utime(path, (mtime, mtime))
+
+            FoamFieldFile.cache_dir = None
+            t_parse = open_field(path)
+
+            FoamFieldFile.cache_dir = Path(tmp) / "cache"
+            open_field(path)
+            t_cached = open_field(path)
+
+            print(f"{size:>10} {t_parse * 1e3:>11.1f} {t_cached * 1e3:>12.1f}")
+
+
+if __name__ == "__main__":
+    main()
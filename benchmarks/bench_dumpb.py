@@ -0,0 +1,37 @@
+"""Serialization throughput (MB/s) of NumPy fields vs. the equivalent nested lists."""
+
+import time
+
+import numpy as np
+from foamlib._files._serialization import Kind, dumpb
+
+SIZES = [10**4, 10**5, 10**6]
+
+
+def throughput(data: object, kind: Kind) -> float:
+    start = time.perf_counter()
+    size = len(dumpb(data, kind=kind))  # type: ignore [arg-type]
+    return size / (time.perf_counter() - start) / 1e6
+
+
+def main() -> None:
+    rng = np.random.default_rng(0)
+    print(
+        f"{'field':>8} {'cells':>10} {'kind':>12} {'list [MB/s]':>12}"
+        f" {'array [MB/s]':>13}"
+    )
+    for size in SIZES:
+        for name, arr in [
+            ("scalar", rng.random(size)),
+            ("vector", rng.random((size, 3))),
+        ]:
+            for kind in (Kind.FIELD, Kind.BINARY_FIELD):
+                print(
+                    f"{name:>8} {size:>10} {kind.name:>12}"
+                    f" {throughput(arr.tolist(), kind):>12.2f}"
+                    f" {throughput(arr, kind):>13.2f}"
+                )
+
+
+if __name__ == "__main__":
+    main()
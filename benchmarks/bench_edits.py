@@ -0,0 +1,57 @@
+"""Cost of small edits to a dictionary that also holds a large field."""
+
+import tempfile
+import time
+from pathlib import Path
+
+from foamlib import FoamFieldFile
+
+SIZES = [10**4, 10**5, 10**6]
+EDITS = 100
+
+
+def write_field(path: Path, size: int) -> None:
+    path.write_text(
+        "FoamFile\n{\n    version 2.0;\n    format ascii;\n    class volScalarField;\n}\n"
+        "dimensions [0 2 -2 0 0 0 0];\n"
+        f"internalField nonuniform List<scalar> {size}(\n"
+        + "\n".join(str(float(i)) for i in range(size))
+        + "\n);\n"
+        "boundaryField\n{\n"
+        "    inlet\n    {\n        type zeroGradient;\n    }\n"
+        "    outlet\n    {\n        type fixedValue;\n        value uniform 0;\n    }\n"
+        "}\n"
+    )
+
+
+def main() -> None:
+    with tempfile.TemporaryDirectory() as tmp:
+        print(f"{'cells':>10} {'edit [ms]':>10} {'edit, with [ms]':>16}")
+        for size in SIZES:
+            path = Path(tmp) / f"p{size}"
+            write_field(path, size)
+
+            f = FoamFieldFile(path)
+            f["boundaryField", "outlet", "value"] = 0
+
+            start = time.perf_counter()
+            for i in range(EDITS):
+                f["boundaryField", "outlet", "value"] = i
+                assert f["boundaryField", "inlet", "type"] == "zeroGradient"
+            t_edit = time.perf_counter() - start
+
+            start = time.perf_counter()
+            with f:
+                for i in range(EDITS):
+                    f["boundaryField", "outlet", "value"] = i
+                    assert f["boundaryField", "inlet", "type"] == "zeroGradient"
+            t_with = time.perf_counter() - start
+
+            print(
+                f"{size:>10} {t_edit / EDITS * 1e3:>10.2f}"
+                f" {t_with / EDITS * 1e3:>16.2f}"
+            )
+
+
+if __name__ == "__main__":
+    main()
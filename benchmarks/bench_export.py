@@ -0,0 +1,49 @@
+"""Time to export a case to .npy files, and to read a field back from the export against parsing it again."""
+
+import tempfile
+import time
+from pathlib import Path
+
+import numpy as np
+from foamlib import FoamCase, FoamFieldFile
+
+TIMES = 200
+CELLS = 100_000
+PROBES = [0, 1_000, 50_000, 99_999]
+
+
+def write_case(path: Path) -> None:
+    values = np.random.default_rng(0).random(CELLS)
+    for i in range(TIMES):
+        (path / str(i)).mkdir(parents=True)
+        field = path / str(i) / "p"
+        field.touch()
+        f = FoamFieldFile(field)
+        f["FoamFile"] = {"class": "volScalarField"}
+        f["dimensions"] = FoamFieldFile.DimensionSet(length=2, time=-2)
+        f.internal_field = values + i
+        f["boundaryField"] = {"walls": {"type": "zeroGradient"}}
+
+
+def main() -> None:
+    with tempfile.TemporaryDirectory() as tmp:
+        write_case(Path(tmp) / "case")
+        case = FoamCase(Path(tmp) / "case")
+        print(f"{TIMES} times x {CELLS} cells (ASCII)")
+
+        start = time.perf_counter()
+        case.export(Path(tmp) / "export", mesh=False)
+        print(f"export: {time.perf_counter() - start:.2f} s")
+
+        start = time.perf_counter()
+        case.time_series("p", PROBES)
+        print(f"time_series: {(time.perf_counter() - start) * 1e3:.0f} ms")
+
+        start = time.perf_counter()
+        path = Path(tmp) / "export" / "fields" / "p" / "values.npy"
+        np.load(path, mmap_mode="r")[:, PROBES]
+        print(f"np.load (mmap): {(time.perf_counter() - start) * 1e3:.1f} ms")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,78 @@
+"""Peak memory, time and thread scaling for reading and writing compressed (.gz) field files."""
+
+import gzip
+import tempfile
+import time
+import tracemalloc
+from pathlib import Path
+
+import numpy as np
+from foamlib import FoamFieldFile
+
+SIZE = 10**6
+COMPRESSLEVELS = [1, 6, 9]
+THREADS = [1, 4, 16]
+
+
+def contents(size: int) -> bytes:
+    values = np.random.default_rng(0).random(size)
+    return (
+        b"FoamFile\n{\n    version 2.0;\n    format ascii;\n    class volScalarField;\n}\n"
+        b"dimensions [0 2 -2 0 0 0 0];\n"
+        + f"internalField nonuniform List<scalar> {size}(\n".encode()
+        + "\n".join(map(repr, values.tolist())).encode()
+        + b"\n);\n"
+        b"boundaryField\n{\n    wall\n    {\n        type zeroGradient;\n    }\n}\n"
+    )
+
+
+def main() -> None:
+    with tempfile.TemporaryDirectory() as tmp:
+        path = Path(tmp) / "p.gz"
+        uncompressed = contents(SIZE)
+        path.write_bytes(gzip.compress(uncompressed, compresslevel=6))
+        print(
+            f"uncompressed: {len(uncompressed) / 1e6:.1f} MB,"
+            f" compressed: {path.stat().st_size / 1e6:.1f} MB"
+        )
+        del uncompressed
+
+        tracemalloc.start()
+        start = time.perf_counter()
+        f = FoamFieldFile(path)
+        f["boundaryField", "wall", "type"]
+        elapsed = time.perf_counter() - start
+        _, peak = tracemalloc.get_traced_memory()
+        tracemalloc.stop()
+        print(f"read: {elapsed * 1e3:.0f} ms, peak {peak / 1e6:.1f} MB")
+
+        print(f"{'level':>6} {'write [ms]':>11} {'peak [MB]':>10} {'size [MB]':>10}")
+        for level in COMPRESSLEVELS:
+            FoamFieldFile.compresslevel = level
+            tracemalloc.start()
+            start = time.perf_counter()
+            f["boundaryField", "wall", "type"] = "fixedValue"
+            elapsed = time.perf_counter() - start
+            _, peak = tracemalloc.get_traced_memory()
+            tracemalloc.stop()
+            print(
+                f"{level:>6} {elapsed * 1e3:>11.0f} {peak / 1e6:>10.1f}"
+                f" {path.stat().st_size / 1e6:>10.1f}"
+            )
+
+        FoamFieldFile.compresslevel = 6
+        size = len(gzip.decompress(path.read_bytes()))
+        print(f"{'threads':>7} {'write [MB/s]':>13} {'size [MB]':>10}")
+        for threads in THREADS:
+            FoamFieldFile.compression_threads = threads
+            start = time.perf_counter()
+            f["boundaryField", "wall", "type"] = "zeroGradient"
+            elapsed = time.perf_counter() - start
+            print(
+                f"{threads:>7} {size / elapsed / 1e6:>13.1f}"
+                f" {path.stat().st_size / 1e6:>10.1f}"
+            )
+
+
+if __name__ == "__main__":
+    main()
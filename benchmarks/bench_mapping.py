@@ -0,0 +1,40 @@
+"""Time to assign a boundaryField with many patches to a field file."""
+
+import tempfile
+import time
+from pathlib import Path
+
+from foamlib import FoamFieldFile
+
+PATCHES = [10, 100, 200, 1000]
+
+
+def main() -> None:
+    with tempfile.TemporaryDirectory() as tmp:
+        print(f"{'patches':>10} {'assign [ms]':>12}")
+        for n in PATCHES:
+            path = Path(tmp) / f"U{n}"
+            path.write_text(
+                "FoamFile\n{\n    version 2.0;\n    format ascii;\n"
+                "    class volVectorField;\n}\n"
+                "dimensions [0 1 -1 0 0 0 0];\n"
+                "internalField uniform (0 0 0);\n"
+            )
+            boundary_field = {
+                f"patch{i}": {"type": "fixedValue", "value": [1.0, 0.0, 0.0]}
+                if i % 2
+                else {"type": "zeroGradient"}
+                for i in range(n)
+            }
+
+            f = FoamFieldFile(path)
+            start = time.perf_counter()
+            f["boundaryField"] = boundary_field
+            elapsed = time.perf_counter() - start
+
+            assert len(f.boundary_field) == n
+            print(f"{n:>10} {elapsed * 1e3:>12.2f}")
+
+
+if __name__ == "__main__":
+    main()
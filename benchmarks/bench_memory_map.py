@@ -0,0 +1,51 @@
+"""Time to open a binary field file and read one boundary type, with and without memory mapping."""
+
+import tempfile
+import time
+from pathlib import Path
+
+import numpy as np
+from foamlib import FoamFieldFile
+
+SIZES = [10**5, 10**6, 10**7]
+
+
+def write_field(path: Path, size: int) -> None:
+    path.write_bytes(
+        b"FoamFile\n{\n    version 2.0;\n    format binary;\n    class volVectorField;\n}\n"
+        b"dimensions [0 1 -1 0 0 0 0];\n"
+        + f"internalField nonuniform List<vector> {size}(".encode()
+        + np.random.default_rng(0).random((size, 3)).tobytes()
+        + b");\n"
+        b"boundaryField\n{\n"
+        b"    inlet\n    {\n        type fixedValue;\n        value uniform (1 0 0);\n    }\n"
+        b"    outlet\n    {\n        type zeroGradient;\n    }\n"
+        b"}\n"
+    )
+
+
+def open_and_read_type(path: Path, *, memory_map: bool) -> float:
+    start = time.perf_counter()
+    f = FoamFieldFile(path, memory_map=memory_map)
+    assert f.boundary_field["outlet"].type == "zeroGradient"
+    return time.perf_counter() - start
+
+
+def main() -> None:
+    with tempfile.TemporaryDirectory() as tmp:
+        print(f"{'cells':>10} {'size [MB]':>10} {'read [ms]':>10} {'mmap [ms]':>10}")
+        for size in SIZES:
+            path = Path(tmp) / f"U{size}"
+            write_field(path, size)
+
+            t_read = open_and_read_type(path, memory_map=False)
+            t_mmap = open_and_read_type(path, memory_map=True)
+
+            print(
+                f"{size:>10} {path.stat().st_size / 1e6:>10.1f}"
+                f" {t_read * 1e3:>10.2f} {t_mmap * 1e3:>10.2f}"
+            )
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,132 @@
+"""Time to load the points, faces and owner of a mesh with FoamMesh, against parsing the same files with FoamFile, and to compute its cell centres and volumes."""
+
+import tempfile
+import time
+from pathlib import Path
+
+import numpy as np
+from foamlib import FoamFile, FoamMesh
+
+N_CELLS = 10**6
+
+
+def header(cls: str, *, binary: bool) -> bytes:
+    return (
+        "FoamFile\n{\n    version 2.0;\n"
+        f"    format {'binary' if binary else 'ascii'};\n"
+        f"    class {cls};\n}}\n"
+    ).encode()
+
+
+def write_mesh(path: Path, n_cells: int, *, binary: bool) -> None:
+    # Sizes of a hexahedral mesh; the connectivity itself does not matter here
+    path.mkdir(parents=True)
+    n_faces = 3 * n_cells
+    points = np.random.default_rng(0).random((n_cells, 3))
+    faces_array = np.arange(4 * n_faces).reshape(-1, 4) % n_cells
+    owner_array = np.arange(n_faces) // 3
+    neighbour_array = (owner_array[: 2 * n_cells] + 1) % n_cells
+
+    def write(name: str, cls: str, body: bytes) -> None:
+        (path / name).write_bytes(header(cls, binary=binary) + body)
+
+    if binary:
+        write(
+            "points",
+            "vectorField",
+            f"{len(points)}\n(".encode() + points.tobytes() + b")\n",
+        )
+        offsets = np.arange(0, 4 * len(faces_array) + 1, 4, dtype=np.int32)
+        write(
+            "faces",
+            "faceCompactList",
+            f"{len(offsets)}\n(".encode()
+            + offsets.tobytes()
+            + f")\n{faces_array.size}\n(".encode()
+            + faces_array.astype(np.int32).tobytes()
+            + b")\n",
+        )
+        write(
+            "owner",
+            "labelList",
+            f"{len(owner_array)}\n(".encode()
+            + owner_array.astype(np.int32).tobytes()
+            + b")\n",
+        )
+        write(
+            "neighbour",
+            "labelList",
+            f"{len(neighbour_array)}\n(".encode()
+            + neighbour_array.astype(np.int32).tobytes()
+            + b")\n",
+        )
+    else:
+        write(
+            "points",
+            "vectorField",
+            f"{len(points)}\n(\n".encode()
+            + "\n".join(f"({x} {y} {z})" for x, y, z in points.tolist()).encode()
+            + b"\n)\n",
+        )
+        write(
+            "faces",
+            "faceList",
+            f"{len(faces_array)}\n(\n".encode()
+            + "\n".join(
+                f"4({a} {b} {c} {d})" for a, b, c, d in faces_array.tolist()
+            ).encode()
+            + b"\n)\n",
+        )
+        write(
+            "owner",
+            "labelList",
+            f"{len(owner_array)}\n(\n".encode()
+            + "\n".join(map(str, owner_array.tolist())).encode()
+            + b"\n)\n",
+        )
+        write(
+            "neighbour",
+            "labelList",
+            f"{len(neighbour_array)}\n(\n".encode()
+            + "\n".join(map(str, neighbour_array.tolist())).encode()
+            + b"\n)\n",
+        )
+
+
+def main() -> None:
+    with tempfile.TemporaryDirectory() as tmp:
+        print(f"{N_CELLS} cells")
+        print(
+            f"{'format':>7} {'FoamFile [ms]':>14} {'FoamMesh [ms]':>14}"
+            f" {'geometry [ms]':>14}"
+        )
+        for binary in (False, True):
+            path = Path(tmp) / ("binary" if binary else "ascii")
+            write_mesh(path, N_CELLS, binary=binary)
+
+            start = time.perf_counter()
+            for name in ("points", "faces", "owner"):
+                FoamFile(path / name)[""]
+            t_file = time.perf_counter() - start
+
+            start = time.perf_counter()
+            mesh = FoamMesh(path)
+            mesh.points
+            mesh.face_points
+            mesh.owner
+            t_mesh = time.perf_counter() - start
+
+            start = time.perf_counter()
+            mesh.cell_centres
+            mesh.cell_volumes
+            t_geometry = time.perf_counter() - start
+
+            print(
+                f"{'binary' if binary else 'ascii':>7}"
+                f" {t_file * 1e3:>14.0f} {t_mesh * 1e3:>14.0f}"
+                f" {t_geometry * 1e3:>14.0f}"
+            )
+
+
+if __name__ == "__main__":
+    main()
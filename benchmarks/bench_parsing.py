@@ -0,0 +1,88 @@
+"""Parse throughput (MB/s) of the hand-written parser vs. the pyparsing grammar."""
+
+import random
+import sys
+import time
+
+if sys.version_info >= (3, 9):
+    from collections.abc import Callable
+else:
+    from typing import Callable
+
+from foamlib._files._fast_parsing import parse
+from foamlib._files._parsing import Parsed
+
+HEADER = (
+    "FoamFile\n{{\n    version 2.0;\n    format ascii;\n"
+    "    class {cls};\n    object {obj};\n}}\n"
+)
+SIZE = 10**4
+
+
+def scalar_field(n: int) -> bytes:
+    values = "\n".join(str(random.random()) for _ in range(n))
+    return (
+        HEADER.format(cls="volScalarField", obj="p")
+        + "dimensions [0 2 -2 0 0 0 0];\n"
+        + f"internalField nonuniform List<scalar> {n}\n(\n{values}\n);\n"
+        + "boundaryField\n{\n    wall\n    {\n        type zeroGradient;\n    }\n}\n"
+    ).encode()
+
+
+def vector_field(n: int) -> bytes:
+    values = "\n".join(
+        f"({random.random()} {random.random()} {random.random()})" for _ in range(n)
+    )
+    return (
+        HEADER.format(cls="volVectorField", obj="U")
+        + "dimensions [0 1 -1 0 0 0 0];\n"
+        + f"internalField nonuniform List<vector> {n}\n(\n{values}\n);\n"
+        + "boundaryField\n{\n    wall\n    {\n        type noSlip;\n    }\n}\n"
+    ).encode()
+
+
+def faces(n: int) -> bytes:
+    values = "\n".join(
+        f"4({i} {i + 1} {i + 2} {i + 3})" if i % 2 else f"3({i} {i + 1} {i + 2})"
+        for i in range(n)
+    )
+    return (
+        HEADER.format(cls="faceList", obj="faces") + f"{n}\n(\n{values}\n)\n"
+    ).encode()
+
+
+def dictionary(n: int) -> bytes:
+    entries = "\n".join(
+        f"solver{i}\n{{\n    solver GAMG;\n    tolerance 1e-06;\n    relTol 0.1;\n"
+        f'    smoother GaussSeidel;\n    "(U|k|epsilon)" {{ nSweeps {i}; }}\n}}'
+        for i in range(n)
+    )
+    return (HEADER.format(cls="dictionary", obj="fvSolution") + entries).encode()
+
+
+def throughput(func: Callable[[bytes], object], contents: bytes) -> float:
+    start = time.perf_counter()
+    func(contents)
+    return len(contents) / (time.perf_counter() - start) / 1e6
+
+
+def main() -> None:
+    print(
+        f"{'file':>16} {'size [MB]':>10} {'fast [MB/s]':>12}"
+        f" {'pyparsing [MB/s]':>17}"
+    )
+    for name, contents in [
+        ("internalField<s>", scalar_field(SIZE)),
+        ("internalField<v>", vector_field(SIZE)),
+        ("faces", faces(SIZE)),
+        ("dictionary", dictionary(SIZE // 100)),
+    ]:
+        print(
+            f"{name:>16} {len(contents) / 1e6:>10.2f}"
+            f" {throughput(parse, contents):>12.2f}"
+            f" {throughput(Parsed._parse_with_pyparsing, contents):>17.2f}"
+        )
+
+
+if __name__ == "__main__":
+    main()
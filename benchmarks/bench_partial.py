@@ -0,0 +1,57 @@
+"""Time to read the boundary types of a field file, parsing it fully or lazily."""
+
+import time
+
+import numpy as np
+from foamlib._files._parsing import Parsed
+
+SIZES = [10**4, 10**5, 10**6]
+
+
+def contents(size: int, *, binary: bool) -> bytes:
+    values = np.arange(3 * size, dtype=float).reshape(-1, 3)
+    if binary:
+        internal_field = values.tobytes()
+    else:
+        internal_field = "\n".join(f"({x} {y} {z})" for x, y, z in values).encode()
+
+    return (
+        b"FoamFile\n{\n    version 2.0;\n"
+        + (b"    format binary;\n" if binary else b"    format ascii;\n")
+        + b"    class volVectorField;\n}\n"
+        b"dimensions [0 1 -1 0 0 0 0];\n"
+        + f"internalField nonuniform List<vector> {size}(".encode()
+        + internal_field
+        + b");\n"
+        b"boundaryField\n{\n"
+        b"    inlet\n    {\n        type fixedValue;\n        value uniform (1 0 0);\n"
+        b"    }\n"
+        b"    outlet\n    {\n        type zeroGradient;\n    }\n"
+        b"}\n"
+    )
+
+
+def boundary_types(data: bytes, *, lazy: bool) -> float:
+    start = time.perf_counter()
+    parsed = Parsed(data, lazy=lazy)
+    for keywords in parsed:
+        if keywords[0] == "boundaryField" and keywords[-1] == "type":
+            parsed[keywords]
+    return time.perf_counter() - start
+
+
+def main() -> None:
+    print(f"{'cells':>10} {'format':>7} {'full [ms]':>10} {'lazy [ms]':>10}")
+    for size in SIZES:
+        for binary in (False, True):
+            data = contents(size, binary=binary)
+            t_full = boundary_types(data, lazy=False)
+            t_lazy = boundary_types(data, lazy=True)
+            print(
+                f"{size:>10} {'binary' if binary else 'ascii':>7}"
+                f" {t_full * 1e3:>10.2f} {t_lazy * 1e3:>10.2f}"
+            )
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,77 @@
+"""Time to read a field from all processor directories of a decomposed case, by number of workers, and to reconstruct and decompose it."""
+
+import os
+import tempfile
+import time
+from pathlib import Path
+
+import numpy as np
+from foamlib import FoamCase, FoamFieldFile
+
+PROCESSORS = 64
+CELLS = 20_000  # per processor
+WORKERS = [1, 2, 4, 8, 16]
+
+
+def decompose(path: Path, *, binary: bool) -> None:
+    values = np.random.default_rng(0).random((CELLS, 3))
+    for i in range(PROCESSORS):
+        mesh = path / f"processor{i}" / "constant" / "polyMesh"
+        mesh.mkdir(parents=True)
+        addressing = np.arange(CELLS, dtype=np.int32) * PROCESSORS + i
+        (mesh / "cellProcAddressing").write_bytes(
+            b"FoamFile\n{\n    version 2.0;\n    format binary;\n"
+            b"    class labelList;\n}\n"
+            + f"{CELLS}\n(".encode()
+            + addressing.tobytes()
+            + b")\n"
+        )
+
+        (path / f"processor{i}" / "0").mkdir(parents=True)
+        field = path / f"processor{i}" / "0" / "U"
+        field.touch()
+        f = FoamFieldFile(field)
+        f["FoamFile"] = {
+            "format": "binary" if binary else "ascii",
+            "class": "volVectorField",
+        }
+        f["dimensions"] = FoamFieldFile.DimensionSet(length=1, time=-1)
+        f.internal_field = values
+        f["boundaryField"] = {}
+
+
+def main() -> None:
+    print(f"{PROCESSORS} processors x {CELLS} cells, {os.cpu_count()} CPUs")
+    print(f"{'format':>7} {'workers':>8} {'threads [ms]':>13} {'processes [ms]':>15}")
+    for binary in (False, True):
+        with tempfile.TemporaryDirectory() as tmp:
+            decompose(Path(tmp), binary=binary)
+            case = FoamCase(tmp)
+
+            for workers in WORKERS:
+                times = []
+                for processes in (False, True):
+                    start = time.perf_counter()
+                    case.processor_fields(
+                        "U", max_workers=workers, processes=processes
+                    )
+                    times.append(time.perf_counter() - start)
+
+                print(
+                    f"{'binary' if binary else 'ascii':>7} {workers:>8}"
+                    f" {times[0] * 1e3:>13.0f} {times[1] * 1e3:>15.0f}"
+                )
+
+            start = time.perf_counter()
+            U = case.reconstruct_field("U", processes=not binary)
+            elapsed = time.perf_counter() - start
+            print(f"reconstruct_field: {elapsed * 1e3:.0f} ms")
+
+            start = time.perf_counter()
+            case.decompose_field("U", U, processes=not binary)
+            elapsed = time.perf_counter() - start
+            print(f"decompose_field: {elapsed * 1e3:.0f} ms")
+
+
+if __name__ == "__main__":
+    main()
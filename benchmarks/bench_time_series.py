@@ -0,0 +1,58 @@
+"""Time to extract the values of a field at a few cells across many time directories."""
+
+import tempfile
+import time
+from pathlib import Path
+
+import numpy as np
+from foamlib import FoamCase, FoamFieldFile
+
+TIMES = 1_000
+CELLS = 100_000
+PROBES = [0, 1_000, 50_000, 99_999]
+
+
+def write_case(path: Path, *, binary: bool) -> None:
+    values = np.random.default_rng(0).random(CELLS)
+    for i in range(TIMES):
+        (path / str(i)).mkdir()
+        field = path / str(i) / "p"
+        field.touch()
+        f = FoamFieldFile(field)
+        f["FoamFile"] = {
+            "format": "binary" if binary else "ascii",
+            "class": "volScalarField",
+        }
+        f["dimensions"] = FoamFieldFile.DimensionSet(length=2, time=-2)
+        f.internal_field = values + i
+        f["boundaryField"] = {"walls": {"type": "zeroGradient"}}
+
+
+def main() -> None:
+    print(f"{TIMES} times x {CELLS} cells")
+    print(f"{'format':>7} {'loop [s]':>9} {'threads [s]':>12} {'processes [s]':>14}")
+    for binary in (False, True):
+        with tempfile.TemporaryDirectory() as tmp:
+            write_case(Path(tmp), binary=binary)
+            case = FoamCase(tmp)
+
+            start = time.perf_counter()
+            np.stack([t["p"].internal_field[PROBES] for t in case])  # type: ignore [index]
+            t_loop = time.perf_counter() - start
+
+            start = time.perf_counter()
+            case.time_series("p", PROBES, processes=False)
+            t_threads = time.perf_counter() - start
+
+            start = time.perf_counter()
+            case.time_series("p", PROBES)
+            t_processes = time.perf_counter() - start
+
+            print(
+                f"{'binary' if binary else 'ascii':>7} {t_loop:>9.2f}"
+                f" {t_threads:>12.2f} {t_processes:>14.2f}"
+            )
+
+
+if __name__ == "__main__":
+    main()
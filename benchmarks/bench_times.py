@@ -0,0 +1,52 @@
+"""Time to look up time directories in a case with many write times."""
+
+import os
+import tempfile
+import time
+from pathlib import Path
+
+from foamlib import FoamCase
+
+TIMES = 50_000
+LOOKUPS = 1_000
+
+
+def main() -> None:
+    with tempfile.TemporaryDirectory() as tmp:
+        for i in range(TIMES):
+            (Path(tmp) / f"{i * 1e-3:g}").mkdir()
+        # The index of a directory modified in the last 2 s is not reused,
+        # as a later change may not alter its timestamp; backdate it
+        mtime = time.time() - 10
+        os.utime(tmp, (mtime, mtime))
+
+        case = FoamCase(tmp)
+
+        start = time.perf_counter()
+        len(case)
+        print(f"index {TIMES} times: {(time.perf_counter() - start) * 1e3:.0f} ms")
+
+        start = time.perf_counter()
+        for _ in range(LOOKUPS):
+            case[-1]
+        elapsed = time.perf_counter() - start
+        print(f"case[-1]: {elapsed / LOOKUPS * 1e6:.1f} us")
+
+        start = time.perf_counter()
+        for i in range(LOOKUPS):
+            case[i * 0.049]
+        elapsed = time.perf_counter() - start
+        print(f"case[t]: {elapsed / LOOKUPS * 1e6:.1f} us")
+
+        # Right after a new time is written, the index is checked against
+        # the directory on each access, but only new entries are indexed
+        (Path(tmp) / f"{TIMES * 1e-3:g}").mkdir()
+        start = time.perf_counter()
+        for _ in range(10):
+            case[-1]
+        elapsed = time.perf_counter() - start
+        print(f"case[-1] after a write: {elapsed / 10 * 1e3:.1f} ms")
+
+
+if __name__ == "__main__":
+    main()
@@ -4,6 +4,7 @@ __version__ = "0.3.10"
 
 from ._cases import AsyncFoamCase, FoamCase, FoamCaseBase
 from ._files import FoamDict, FoamFieldFile, FoamFile
+from ._mesh import FoamMesh
 from ._util import CalledProcessError, CalledProcessWarning
 
 __all__ = [
@@ -13,6 +14,7 @@ __all__ = [
     "FoamFile",
     "FoamFieldFile",
     "FoamDict",
+    "FoamMesh",
     "CalledProcessError",
     "CalledProcessWarning",
 ]
@@ -1,12 +1,19 @@
 import asyncio
+import bisect
+import functools
 import multiprocessing
+import os
 import shutil
 import sys
 from contextlib import asynccontextmanager
 from pathlib import Path
 from typing import (
+    Any,
+    List,
     Optional,
+    Tuple,
     Union,
+    cast,
     overload,
 )
 
@@ -24,14 +31,27 @@ else:
     from typing import AsyncGenerator, Callable, Collection, Iterator, Sequence
 
 import aioshutil
+import numpy as np
 
+from ._decomposition import decompose, reconstruct
+from ._export import open_store
 from ._files import FoamFieldFile, FoamFile
-from ._util import is_sequence, run_process, run_process_async
+from ._mesh import FoamMesh
+from ._parallel import parallel_map
+from ._util import is_racy, is_sequence, run_process, run_process_async
 
 
 class FoamCaseBase(Sequence["FoamCaseBase.TimeDirectory"]):
     def __init__(self, path: Union[Path, str] = Path()):
         self.path = Path(path).absolute()
+        self.__times: Optional[
+            Tuple[
+                Optional[Tuple[int, int]],
+                List[float],
+                List[FoamCaseBase.TimeDirectory],
+                List[str],
+            ]
+        ] = None
 
     class TimeDirectory(Set[FoamFieldFile]):
         """
@@ -92,21 +112,81 @@ class FoamCaseBase(Sequence["FoamCaseBase.TimeDirectory"]):
         def __str__(self) -> str:
             return str(self.path)
 
+    def _time_index(self) -> Tuple[List[float], List["FoamCaseBase.TimeDirectory"]]:
+        # Sorted times and time directories, cached until the case directory
+        # changes (adding or removing a directory updates its mtime)
+        stat = self.path.stat()
+        key = (stat.st_mtime_ns, stat.st_nlink)
+        if self.__times is not None and self.__times[0] == key:
+            return self.__times[1], self.__times[2]
+
+        with os.scandir(self.path) as it:
+            entries = {entry.name: entry for entry in it}
+
+        # Update the previous index rather than rebuilding it, so that new
+        # write times cost only their own entries. New lists are made, as
+        # the old ones may still be in use by callers
+        if self.__times is not None:
+            _, values, times, names = self.__times
+            if not all(name in entries for name in names):
+                kept = [i for i, name in enumerate(names) if name in entries]
+                values = [values[i] for i in kept]
+                times = [times[i] for i in kept]
+                names = [names[i] for i in kept]
+        else:
+            values, times, names = [], [], []
+
+        known = set(names)
+        added = []
+        for name, entry in entries.items():
+            if name in known:
+                continue
+            try:
+                value = float(name)
+            except ValueError:
+                continue
+            if entry.is_dir():
+                added.append((value, name))
+
+        if added:
+            added.sort()
+            new = [
+                (value, FoamCaseBase.TimeDirectory(self.path / name), name)
+                for value, name in added
+            ]
+            if not values or added[0] > (values[-1], names[-1]):
+                # The usual case: times written after all the others
+                values = [*values, *(value for value, _, _ in new)]
+                times = [*times, *(time for _, time, _ in new)]
+                names = [*names, *(name for _, _, name in new)]
+            else:
+                merged = sorted(
+                    [*zip(values, times, names), *new],
+                    key=lambda entry: (entry[0], entry[2]),
+                )
+                values = [value for value, _, _ in merged]
+                times = [time for _, time, _ in merged]
+                names = [name for _, _, name in merged]
+
+        # A later change within the timestamp resolution of the filesystem
+        # could leave the mtime unchanged, so an index updated that soon
+        # after the last change is checked again on the next access
+        racy = is_racy(stat.st_mtime_ns)
+        self.__times = (None if racy else key, values, times, names)
+
+        return values, times
+
     @property
     def _times(self) -> Sequence["FoamCaseBase.TimeDirectory"]:
-        times = []
-        for p in self.path.iterdir():
-            if p.is_dir():
-                try:
-                    float(p.name)
-                except ValueError:
-                    pass
-                else:
-                    times.append(FoamCaseBase.TimeDirectory(p))
+        return self._time_index()[1]
 
-        times.sort(key=lambda t: t.time)
-
-        return times
+    @property
+    def _time_precision(self) -> int:
+        try:
+            precision = self.control_dict.get("timePrecision", 6)
+        except FileNotFoundError:
+            return 6
+        return precision if isinstance(precision, int) else 6
 
     @overload
     def __getitem__(
@@ -122,15 +202,30 @@ class FoamCaseBase(Sequence["FoamCaseBase.TimeDirectory"]):
         if isinstance(index, str):
             return FoamCaseBase.TimeDirectory(self.path / index)
         elif isinstance(index, float):
-            for time in self._times:
-                if time.time == index:
-                    return time
+            values, times = self._time_index()
+            i = bisect.bisect_left(values, index)
+            if i < len(values) and values[i] == index:
+                return times[i]
+
+            # Otherwise, accept the closest time with the same name when
+            # written with timePrecision significant digits, as OpenFOAM does
+            precision = self._time_precision
+            name = f"{index:.{precision}g}"
+            for j in sorted(
+                (j for j in (i - 1, i) if 0 <= j < len(values)),
+                key=lambda j: abs(values[j] - index),
+            ):
+                if f"{values[j]:.{precision}g}" == name:
+                    return times[j]
             raise IndexError(f"Time {index} not found")
         return self._times[index]
 
     def __len__(self) -> int:
         return len(self._times)
 
+    def __iter__(self) -> Iterator["FoamCaseBase.TimeDirectory"]:
+        return iter(self._times)
+
     def _clean_paths(self) -> Set[Path]:
         has_decompose_par_dict = (self.path / "system" / "decomposeParDict").is_file()
         has_block_mesh_dict = (self.path / "system" / "blockMeshDict").is_file()
@@ -246,11 +341,367 @@ class FoamCaseBase(Sequence["FoamCaseBase.TimeDirectory"]):
         except FileNotFoundError:
             return None
 
+    def _global_n_cells(self, processors: Sequence["FoamCaseBase"]) -> Optional[int]:
+        # So that a missing processor directory does not go unnoticed, check
+        # the processor directories against numberOfSubdomains and take the
+        # number of cells from the complete mesh, if there is one
+        nsubdomains = self._nsubdomains
+        if nsubdomains is not None and len(processors) != nsubdomains:
+            raise ValueError(
+                f"Found {len(processors)} processor directories in {self}, "
+                f"expected {nsubdomains}"
+            )
+
+        mesh = self.mesh
+        if not any((mesh.path / name).is_file() for name in ("owner", "owner.gz")):
+            return None
+        return mesh.n_cells
+
     @property
     def _nprocessors(self) -> int:
         """Return the number of processor directories in the case."""
         return len(list(self.path.glob("processor*")))
 
+    @property
+    def processors(self) -> Sequence["FoamCaseBase"]:
+        """The processor directories of a decomposed case, in order (`processor0`, `processor1`, ...)."""
+        paths = [
+            p
+            for p in self.path.glob("processor*")
+            if p.name[len("processor") :].isdigit() and p.is_dir()
+        ]
+        paths.sort(key=lambda p: int(p.name[len("processor") :]))
+        return [FoamCaseBase(p) for p in paths]
+
+    def processor_fields(
+        self,
+        field: str,
+        time: Union[int, float, str] = -1,
+        *,
+        max_workers: Optional[int] = None,
+        processes: bool = True,
+    ) -> List[FoamFieldFile.Data]:
+        """
+        Read the internal field of a field file from all processor directories at once.
+
+        :param field: The name of the field, e.g. `"U"`.
+        :param time: The time directory, by index, time value or name (as for `case[time]`). Defaults to the latest time.
+        :param max_workers: The maximum number of files read at the same time. Defaults to the number of CPUs.
+        :param processes: Whether to read files in separate processes (the default), which is faster for ASCII files. If False, use threads instead, which avoids the cost of sending the results back.
+
+        :return: The internal field of each processor, in the order of `processors`.
+        """
+        processors = self.processors
+        if not processors:
+            raise FileNotFoundError(f"No processor directories in {self}")
+
+        name = processors[0][time].name
+        return parallel_map(
+            functools.partial(_read_internal_field, field=field),
+            [p.path / name for p in processors],
+            max_workers=max_workers,
+            processes=processes,
+        )
+
+    def reconstruct_field(
+        self,
+        field: str,
+        time: Union[int, float, str] = -1,
+        *,
+        max_workers: Optional[int] = None,
+        processes: bool = True,
+    ) -> "np.ndarray[Any, Any]":
+        """
+        Assemble the internal field of the complete mesh from the processor directories of a decomposed case, without running `reconstructPar`.
+
+        Only the requested field and time are read. Cells are mapped using the `cellProcAddressing` files written by `decomposePar`. If the case has a decomposeParDict or a complete mesh in constant/polyMesh, they are used to check that no processor directory is missing.
+
+        :param field: The name of the field, e.g. `"U"`.
+        :param time: The time directory, by index, time value or name (as for `case[time]`). Defaults to the latest time.
+        :param max_workers: The maximum number of processor directories read at the same time. Defaults to the number of CPUs.
+        :param processes: Whether to read files in separate processes (the default). If False, use threads instead.
+
+        :return: The values of the field in all cells of the complete mesh.
+
+        :raises ValueError: If the processor directories do not cover all cells of the complete mesh.
+        """
+        processors = self.processors
+        if not processors:
+            raise FileNotFoundError(f"No processor directories in {self}")
+
+        name = processors[0][time].name
+        n_cells = self._global_n_cells(processors)
+        return reconstruct(
+            parallel_map(
+                functools.partial(_read_processor_field, time=name, field=field),
+                [p.path for p in processors],
+                max_workers=max_workers,
+                processes=processes,
+            ),
+            n_cells,
+        )
+
+    def decompose_field(
+        self,
+        field: str,
+        values: "np.ndarray[Any, Any]",
+        time: Union[int, float, str] = 0,
+        *,
+        max_workers: Optional[int] = None,
+        processes: bool = True,
+    ) -> None:
+        """
+        Set the internal field of a field file in all processor directories of a decomposed case from its values on the complete mesh, without running `decomposePar`.
+
+        The field file must already exist in each processor directory; only its internal field is replaced, so that the rest of the file (e.g. the boundary field) is kept. Cells are mapped using the `cellProcAddressing` files written by `decomposePar`. If the case has a decomposeParDict or a complete mesh in constant/polyMesh, they are used to check that no processor directory is missing.
+
+        :param field: The name of the field, e.g. `"U"`.
+        :param values: The values of the field in all cells of the complete mesh.
+        :param time: The time directory, by index, time value or name (as for `case[time]`). Defaults to the first time.
+        :param max_workers: The maximum number of processor directories read or written at the same time. Defaults to the number of CPUs.
+        :param processes: Whether to read and write files in separate processes (the default). If False, use threads instead.
+
+        :raises ValueError: If the number of values does not match the number of cells of the complete mesh, or if the processor directories do not cover all of its cells.
+        """
+        processors = self.processors
+        if not processors:
+            raise FileNotFoundError(f"No processor directories in {self}")
+
+        name = processors[0][time].name
+        n_cells = self._global_n_cells(processors)
+        addressings = parallel_map(
+            _read_cell_proc_addressing,
+            [p.path for p in processors],
+            max_workers=max_workers,
+            processes=processes,
+        )
+        parallel_map(
+            functools.partial(_write_internal_field, field=field),
+            zip(
+                [p.path / name for p in processors],
+                decompose(np.asarray(values), addressings, n_cells),
+            ),
+            max_workers=max_workers,
+            processes=processes,
+        )
+
+    @overload
+    def time_series(
+        self,
+        field: str,
+        cells: Optional[Sequence[int]] = None,
+        patches: Sequence[str] = (),
+        *,
+        times: Optional[Sequence["FoamCaseBase.TimeDirectory"]] = None,
+        chunk_size: None = None,
+        max_workers: Optional[int] = None,
+        processes: bool = True,
+    ) -> "np.ndarray[Any, Any]": ...
+
+    @overload
+    def time_series(
+        self,
+        field: str,
+        cells: Optional[Sequence[int]] = None,
+        patches: Sequence[str] = (),
+        *,
+        times: Optional[Sequence["FoamCaseBase.TimeDirectory"]] = None,
+        chunk_size: int,
+        max_workers: Optional[int] = None,
+        processes: bool = True,
+    ) -> Iterator["np.ndarray[Any, Any]"]: ...
+
+    def time_series(
+        self,
+        field: str,
+        cells: Optional[Sequence[int]] = None,
+        patches: Sequence[str] = (),
+        *,
+        times: Optional[Sequence["FoamCaseBase.TimeDirectory"]] = None,
+        chunk_size: Optional[int] = None,
+        max_workers: Optional[int] = None,
+        processes: bool = True,
+    ) -> Union["np.ndarray[Any, Any]", Iterator["np.ndarray[Any, Any]"]]:
+        """
+        Extract the values of a field at some cells and boundary patches across time directories.
+
+        Time directories are read in parallel, and only the entries that are needed are parsed from each field file.
+
+        :param field: The name of the field, e.g. `"p"`.
+        :param cells: Labels of the cells to extract. Defaults to all cells. Pass an empty sequence to extract only patch values.
+        :param patches: Names of boundary patches whose face values (the `value` entry of each patch) are extracted after those of the cells. Patches without a `value` entry (e.g. of type zeroGradient, empty or symmetry) cannot be selected, and raise a ValueError.
+        :param times: The time directories to read, e.g. `case[10:]`. Defaults to all time directories.
+        :param chunk_size: If given (must be at least 1), return an iterator over arrays of up to this many consecutive times instead of a single array, so that only one chunk is kept in memory at a time.
+        :param max_workers: The maximum number of time directories read at the same time. Defaults to the number of CPUs.
+        :param processes: Whether to read files in separate processes (the default). If False, use threads instead.
+
+        :return: An array of shape `(ntimes, n)` for scalar fields or `(ntimes, n, k)` otherwise, where `n` counts the selected cells followed by the faces of the selected patches. Row `i` corresponds to `times[i]`.
+        """
+        if chunk_size is not None and chunk_size < 1:
+            raise ValueError(f"chunk_size must be at least 1 (got {chunk_size})")
+
+        if times is None:
+            times = self._times
+
+        chunks = self._time_series_chunks(
+            field,
+            None if cells is None else np.asarray(cells, dtype=int),
+            tuple(patches),
+            times,
+            chunk_size or max(len(times), 1),
+            max_workers=max_workers,
+            processes=processes,
+        )
+
+        if chunk_size is not None:
+            return chunks
+        return next(chunks, np.empty((0, 0)))
+
+    def export(
+        self,
+        path: Union[Path, str],
+        fields: Optional[Sequence[str]] = None,
+        *,
+        times: Optional[Sequence["FoamCaseBase.TimeDirectory"]] = None,
+        format: str = "npy",
+        mesh: bool = True,
+        chunk_size: Optional[int] = None,
+        max_workers: Optional[int] = None,
+        processes: bool = True,
+    ) -> None:
+        """
+        Export fields and the mesh to an on-disk array store, so that later analyses can load them (with random access) without parsing OpenFOAM files again.
+
+        Each field is stored as a single array `fields/<field>/values` of shape `(ntimes, n)` or `(ntimes, n, k)`, along with the times at which the field was found in `fields/<field>/times`. The mesh is stored as `mesh/points`, `mesh/face_offsets`, `mesh/face_points`, `mesh/owner`, `mesh/neighbour`, `mesh/cell_centres` and `mesh/cell_volumes` (see `FoamMesh`). In Zarr stores and HDF5 files, field values are chunked by time, and mesh arrays in blocks of up to 2**20 rows.
+
+        :param path: The path of the store to create. An existing Zarr store or HDF5 file at this path is overwritten; for `"npy"`, only the arrays being exported are replaced.
+        :param fields: The names of the fields to export. Defaults to all fields in the last of `times`. A KeyError is raised if any of them is not found in any of `times`.
+        :param times: The time directories to export, e.g. `case[10:]`. Defaults to all time directories.
+        :param format: `"npy"` (the default) for a directory of `.npy` files, which can be memory-mapped with `np.load(..., mmap_mode="r")`; `"zarr"` for a Zarr store; or `"hdf5"` for an HDF5 file. The last two require the `zarr` and `h5py` packages respectively.
+        :param mesh: Whether to export the mesh.
+        :param chunk_size: The maximum number of time directories read into memory at once. Defaults to the number of workers.
+        :param max_workers: The maximum number of time directories read at the same time. Defaults to the number of CPUs.
+        :param processes: Whether to read files in separate processes (the default). If False, use threads instead.
+        """
+        if times is None:
+            times = self._times
+
+        if fields is None:
+            fields = (
+                sorted(
+                    f.path.name[: -len(".gz")]
+                    if f.path.suffix == ".gz"
+                    else f.path.name
+                    for f in times[-1]
+                )
+                if times
+                else []
+            )
+
+        if chunk_size is None:
+            chunk_size = max_workers or os.cpu_count() or 1
+
+        # Check before anything is written
+        times_by_field = {
+            field: [
+                t
+                for t in times
+                if (t.path / field).is_file() or (t.path / f"{field}.gz").is_file()
+            ]
+            for field in fields
+        }
+        for field, field_times in times_by_field.items():
+            if not field_times:
+                raise KeyError(f"Field {field!r} not found in any of the times")
+
+        store = open_store(Path(path), format)
+        try:
+            if mesh:
+                # A single FoamMesh, so that the geometry is computed once
+                foam_mesh = self.mesh
+                for name in (
+                    "points",
+                    "face_offsets",
+                    "face_points",
+                    "owner",
+                    "neighbour",
+                    "cell_centres",
+                    "cell_volumes",
+                ):
+                    array = np.asarray(getattr(foam_mesh, name))
+                    store.array(f"mesh/{name}", array.shape, array.dtype)[...] = array
+
+            for field, field_times in times_by_field.items():
+                store.array(
+                    f"fields/{field}/times", (len(field_times),), np.dtype(float)
+                )[...] = np.array([t.time for t in field_times], dtype=float)
+
+                values = None
+                start = 0
+                for chunk in self.time_series(
+                    field,
+                    times=field_times,
+                    chunk_size=chunk_size,
+                    max_workers=max_workers,
+                    processes=processes,
+                ):
+                    if values is None:
+                        values = store.array(
+                            f"fields/{field}/values",
+                            (len(field_times), *chunk.shape[1:]),
+                            chunk.dtype,
+                            time_series=True,
+                        )
+                    values[start : start + len(chunk)] = chunk
+                    start += len(chunk)
+        finally:
+            store.close()
+
+    def _time_series_chunks(
+        self,
+        field: str,
+        cells: Optional["np.ndarray[Any, Any]"],
+        patches: Tuple[str, ...],
+        times: Sequence["FoamCaseBase.TimeDirectory"],
+        chunk_size: int,
+        *,
+        max_workers: Optional[int],
+        processes: bool,
+    ) -> Iterator["np.ndarray[Any, Any]"]:
+        mesh = self.mesh
+
+        def size(i: int) -> int:
+            # Number of values in the ith part of a row (cells, then patches)
+            if i == 0:
+                return len(cells) if cells is not None else mesh.n_cells
+            return int(mesh.boundary[patches[i - 1]]["nFaces"])  # type: ignore [arg-type]
+
+        for start in range(0, len(times), chunk_size):
+            rows = parallel_map(
+                functools.partial(
+                    _read_time_values, field=field, cells=cells, patches=patches
+                ),
+                [t.path for t in times[start : start + chunk_size]],
+                max_workers=max_workers,
+                processes=processes,
+            )
+
+            stacked = []
+            for row in rows:
+                parts = []
+                for i, part in enumerate(row):
+                    if part is None:
+                        continue
+                    if not isinstance(part, np.ndarray):
+                        # Uniform value
+                        part = np.asarray(part, dtype=float)
+                        part = np.broadcast_to(part, (size(i), *part.shape))
+                    parts.append(part)
+                # No cells nor patches selected
+                stacked.append(np.concatenate(parts) if parts else np.empty(0))
+
+            yield np.stack(stacked)
+
     @property
     def application(self) -> str:
         """The application name as set in the controlDict."""
@@ -284,6 +735,11 @@ class FoamCaseBase(Sequence["FoamCaseBase.TimeDirectory"]):
         """The blockMeshDict file."""
         return self.file("system/blockMeshDict")
 
+    @property
+    def mesh(self) -> FoamMesh:
+        """The mesh in constant/polyMesh."""
+        return FoamMesh(self.path / "constant" / "polyMesh")
+
     @property
     def transport_properties(self) -> FoamFile:
         """The transportProperties file."""
@@ -304,6 +760,59 @@ class FoamCaseBase(Sequence["FoamCaseBase.TimeDirectory"]):
         return str(self.path)
 
 
+def _read_internal_field(path: Path, field: str) -> FoamFieldFile.Data:
+    # internal_field is never a 0-d array, although its type allows it
+    return cast(
+        FoamFieldFile.Data, FoamCaseBase.TimeDirectory(path)[field].internal_field
+    )
+
+
+def _read_cell_proc_addressing(path: Path) -> "np.ndarray[Any, Any]":
+    return FoamMesh(path / "constant" / "polyMesh").cell_proc_addressing
+
+
+def _read_processor_field(
+    path: Path, time: str, field: str
+) -> Tuple["np.ndarray[Any, Any]", FoamFieldFile.Data]:
+    return _read_cell_proc_addressing(path), _read_internal_field(path / time, field)
+
+
+def _read_time_values(
+    path: Path,
+    field: str,
+    cells: Optional["np.ndarray[Any, Any]"],
+    patches: Tuple[str, ...],
+) -> List[Optional[FoamFieldFile.Data]]:
+    f = FoamFieldFile(FoamCaseBase.TimeDirectory(path)[field].path, memory_map=True)
+
+    # Fields are never 0-d arrays, although their type allows it
+    ret: List[Optional[FoamFieldFile.Data]] = []
+    if cells is None:
+        ret.append(cast(FoamFieldFile.Data, f.internal_field))
+    elif len(cells) > 0:
+        internal = cast(FoamFieldFile.Data, f.internal_field)
+        ret.append(internal[cells] if isinstance(internal, np.ndarray) else internal)
+    else:
+        ret.append(None)
+
+    if patches:
+        boundary_field = f.boundary_field
+        for patch in patches:
+            boundary = boundary_field[patch]
+            if "value" not in boundary:
+                raise ValueError(f"Patch {patch!r} has no value entry in {f.path}")
+            ret.append(cast(FoamFieldFile.Data, boundary.value))
+
+    return ret
+
+
+def _write_internal_field(
+    item: Tuple[Path, "np.ndarray[Any, Any]"], field: str
+) -> None:
+    path, values = item
+    FoamCaseBase.TimeDirectory(path)[field].internal_field = values
+
+
 class FoamCase(FoamCaseBase):
     """
     An OpenFOAM case.
@@ -0,0 +1,83 @@
+import sys
+from typing import Any, List, Optional, Tuple
+
+if sys.version_info >= (3, 9):
+    from collections.abc import Sequence
+else:
+    from typing import Sequence
+
+import numpy as np
+
+from ._files import FoamFieldFile
+
+
+def _n_cells(
+    addressings: Sequence["np.ndarray[Any, Any]"], n_cells: Optional[int]
+) -> int:
+    # Number of cells of the complete mesh. If not given, it is inferred from
+    # the highest cell label, which misses any trailing cells of a missing
+    # processor
+    n = 1 + max(
+        (int(addressing.max()) for addressing in addressings if len(addressing)),
+        default=-1,
+    )
+    if n_cells is None:
+        return n
+    if n > n_cells:
+        raise ValueError(
+            f"cellProcAddressing refers to cell {n - 1} of a mesh with {n_cells} cells"
+        )
+    return n_cells
+
+
+def reconstruct(
+    parts: Sequence[Tuple["np.ndarray[Any, Any]", FoamFieldFile.Data]],
+    n_cells: Optional[int] = None,
+) -> "np.ndarray[Any, Any]":
+    # Assemble the internal field of the complete mesh from the
+    # cellProcAddressing and internal field of each processor. Nonuniform
+    # fields are read as arrays, and uniform fields as plain values
+    n = _n_cells([addressing for addressing, _ in parts], n_cells)
+
+    arrays = [values for _, values in parts if isinstance(values, np.ndarray)]
+    if arrays:
+        shape = arrays[0].shape[1:]
+        dtype = np.result_type(*arrays)
+    else:
+        shape = np.asarray(parts[0][1]).shape if parts else ()
+        dtype = np.dtype(float)
+
+    ret = np.empty((n, *shape), dtype=dtype)
+    covered = np.zeros(n, dtype=bool)
+    for addressing, values in parts:
+        if isinstance(values, np.ndarray) and len(values) != len(addressing):
+            raise ValueError(
+                f"Field has {len(values)} values for {len(addressing)} cells"
+            )
+        ret[addressing] = values
+        covered[addressing] = True
+
+    if not covered.all():
+        raise ValueError(f"cellProcAddressing does not cover all {n} cells")
+
+    return ret
+
+
+def decompose(
+    values: "np.ndarray[Any, Any]",
+    addressings: Sequence["np.ndarray[Any, Any]"],
+    n_cells: Optional[int] = None,
+) -> List["np.ndarray[Any, Any]"]:
+    # Values of each processor, from those of the complete mesh and the
+    # cellProcAddressing of each processor
+    n = _n_cells(addressings, n_cells)
+    if len(values) != n:
+        raise ValueError(f"Field has {len(values)} values for {n} cells")
+
+    covered = np.zeros(n, dtype=bool)
+    for addressing in addressings:
+        covered[addressing] = True
+    if not covered.all():
+        raise ValueError(f"cellProcAddressing does not cover all {n} cells")
+
+    return [values[addressing] for addressing in addressings]
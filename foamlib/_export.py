@@ -0,0 +1,129 @@
+from pathlib import Path
+from typing import Any, Dict, Tuple, Type
+
+import numpy as np
+
+# Rows per chunk of arrays that are not time series (e.g. the points of the
+# mesh), so that large meshes are stored in a bounded number of chunks of
+# bounded size
+_CHUNK_ROWS = 2**20
+
+
+def _chunks(shape: Tuple[int, ...], *, time_series: bool) -> Tuple[int, ...]:
+    if time_series:
+        # One chunk per time, so that reading one time reads one chunk
+        chunks = (1, *shape[1:])
+    else:
+        chunks = (min(shape[0], _CHUNK_ROWS), *shape[1:])
+    return tuple(max(c, 1) for c in chunks)
+
+
+class _Store:
+    def __init__(self, path: Path) -> None:
+        self._path = path
+
+    def array(
+        self,
+        name: str,
+        shape: Tuple[int, ...],
+        dtype: "np.dtype[Any]",
+        *,
+        time_series: bool = False,
+    ) -> Any:
+        # A new array that supports assignment to slices, e.g. a[i:j] = values.
+        # Time series have the time as their first dimension
+        raise NotImplementedError
+
+    def close(self) -> None:
+        pass
+
+
+class _NpyStore(_Store):
+    # A directory tree of .npy files, which np.load can memory-map
+    def __init__(self, path: Path) -> None:
+        super().__init__(path)
+        path.mkdir(parents=True, exist_ok=True)
+
+    def array(
+        self,
+        name: str,
+        shape: Tuple[int, ...],
+        dtype: "np.dtype[Any]",
+        *,
+        time_series: bool = False,
+    ) -> Any:
+        path = self._path / f"{name}.npy"
+        path.parent.mkdir(parents=True, exist_ok=True)
+        if 0 in shape:
+            # Empty arrays cannot be memory-mapped
+            ret = np.empty(shape, dtype=dtype)
+            np.save(path, ret)
+            return ret
+        return np.lib.format.open_memmap(path, mode="w+", dtype=dtype, shape=shape)
+
+
+class _ZarrStore(_Store):
+    def __init__(self, path: Path) -> None:
+        import zarr  # type: ignore [import-not-found]
+
+        super().__init__(path)
+        self._group = zarr.open_group(str(path), mode="w")
+
+    def array(
+        self,
+        name: str,
+        shape: Tuple[int, ...],
+        dtype: "np.dtype[Any]",
+        *,
+        time_series: bool = False,
+    ) -> Any:
+        *groups, name = name.split("/")
+        group = self._group
+        for g in groups:
+            group = group.require_group(g)
+        chunks = _chunks(shape, time_series=time_series)
+        return group.zeros(name=name, shape=shape, chunks=chunks, dtype=dtype)
+
+
+class _Hdf5Store(_Store):
+    def __init__(self, path: Path) -> None:
+        import h5py  # type: ignore [import-not-found]
+
+        super().__init__(path)
+        self._file = h5py.File(path, "w")
+
+    def array(
+        self,
+        name: str,
+        shape: Tuple[int, ...],
+        dtype: "np.dtype[Any]",
+        *,
+        time_series: bool = False,
+    ) -> Any:
+        # Empty datasets are stored contiguously
+        chunks = _chunks(shape, time_series=time_series) if 0 not in shape else None
+        return self._file.create_dataset(name, shape=shape, dtype=dtype, chunks=chunks)
+
+    def close(self) -> None:
+        self._file.close()
+
+
+_STORES: Dict[str, Type[_Store]] = {
+    "npy": _NpyStore,
+    "zarr": _ZarrStore,
+    "hdf5": _Hdf5Store,
+}
+
+
+def open_store(path: Path, format: str) -> _Store:
+    try:
+        store = _STORES[format]
+    except KeyError:
+        raise ValueError(
+            f"Unknown export format {format!r} (expected one of {', '.join(_STORES)})"
+        ) from None
+
+    try:
+        return store(path)
+    except ImportError as e:
+        raise ImportError(f"Exporting to {format} requires the {e.name} package") from e
@@ -8,10 +8,7 @@ if sys.version_info >= (3, 9):
 else:
     from typing import Mapping, Sequence
 
-try:
-    import numpy as np
-except ModuleNotFoundError:
-    pass
+import numpy as np
 
 
 class FoamDict:
@@ -46,6 +43,8 @@ class FoamDict:
         DimensionSet,
         Sequence["Data"],
         Mapping[str, "Data"],
+        "np.ndarray[Tuple[int], np.dtype[np.generic]]",
+        "np.ndarray[Tuple[int, int], np.dtype[np.generic]]",
     ]
     """
     A value that can be stored in an OpenFOAM dictionary.
@@ -0,0 +1,115 @@
+import hashlib
+import os
+import pickle
+import re
+import shutil
+import tempfile
+from pathlib import Path
+from typing import IO, Any, Optional, Tuple, Union
+
+import numpy as np
+
+from ._base import FoamDict
+from ._parsing import Parsed
+
+_VERSION = 2
+
+# The cache directory may be shared, so only the types that make up a parsed
+# file are loaded; anything else (which could run arbitrary code when
+# unpickled) is rejected. Arrays are never pickled, but stored as .npy files
+_GLOBALS = {
+    ("builtins", "Ellipsis"): Ellipsis,
+    **{
+        (cls.__module__, cls.__qualname__): cls
+        for cls in (Parsed, FoamDict.DimensionSet, FoamDict.Dimensioned)
+    },
+}
+_ARRAY_NAME = re.compile(r"[0-9]+\.npy")
+
+
+def key(path: Path, stat: Tuple[int, ...]) -> str:
+    return hashlib.sha256(repr((_VERSION, str(path), stat)).encode()).hexdigest()
+
+
+class _Pickler(pickle.Pickler):
+    def __init__(self, file: IO[bytes], directory: Path) -> None:
+        super().__init__(file, protocol=pickle.HIGHEST_PROTOCOL)
+        self._directory = directory
+        self._narrays = 0
+
+    def persistent_id(self, obj: Any) -> Union[str, Tuple[str, Tuple[int, ...]], None]:
+        if isinstance(obj, np.ndarray):
+            if obj.size == 0:
+                # Empty files cannot be memory-mapped
+                return obj.dtype.str, obj.shape
+            name = f"{self._narrays}.npy"
+            np.save(self._directory / name, obj, allow_pickle=False)
+            self._narrays += 1
+            return name
+        return None
+
+
+class _Unpickler(pickle.Unpickler):
+    def __init__(self, file: IO[bytes], directory: Path) -> None:
+        super().__init__(file)
+        self._directory = directory
+
+    def persistent_load(self, pid: Any) -> Any:
+        if isinstance(pid, str) and _ARRAY_NAME.fullmatch(pid):
+            return np.load(self._directory / pid, mmap_mode="r", allow_pickle=False)
+        if isinstance(pid, tuple) and len(pid) == 2:
+            dtype, shape = pid
+            if (
+                isinstance(dtype, str)
+                and isinstance(shape, tuple)
+                and all(isinstance(n, int) for n in shape)
+                and 0 in shape
+            ):
+                ret = np.empty(shape, dtype=np.dtype(dtype))
+                ret.flags.writeable = False
+                return ret
+        raise pickle.UnpicklingError(f"invalid persistent id {pid!r}")
+
+    def find_class(self, module: str, name: str) -> Any:
+        try:
+            return _GLOBALS[module, name]
+        except KeyError:
+            raise pickle.UnpicklingError(
+                f"global {module}.{name} is forbidden"
+            ) from None
+
+
+def load(cache_dir: Path, key: str) -> Optional[Parsed]:
+    directory = cache_dir / key
+    try:
+        with (directory / "parsed.pickle").open("rb") as f:
+            parsed = _Unpickler(f, directory).load()
+    except (OSError, pickle.UnpicklingError, EOFError, TypeError, ValueError):
+        return None
+
+    return parsed if isinstance(parsed, Parsed) else None
+
+
+def store(cache_dir: Path, key: str, parsed: Parsed) -> None:
+    directory = cache_dir / key
+    if directory.exists():
+        return
+
+    try:
+        cache_dir.mkdir(parents=True, exist_ok=True)
+        tmp = Path(tempfile.mkdtemp(dir=cache_dir, prefix=".tmp-"))
+    except OSError:
+        return
+
+    # Parse any lazily parsed values, which would otherwise be stored along
+    # with the whole of the file contents
+    for keywords in parsed:
+        parsed[keywords]
+
+    try:
+        with (tmp / "parsed.pickle").open("wb") as f:
+            _Pickler(f, tmp).dump(parsed)
+        os.replace(tmp, directory)
+    except OSError:
+        # Also reached if another process stored the same entry first
+        shutil.rmtree(tmp, ignore_errors=True)
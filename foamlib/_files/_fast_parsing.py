@@ -0,0 +1,805 @@
+import re
+import sys
+import warnings
+from typing import Any, Callable, Dict, List, Optional, Tuple, TypeVar, Union, cast
+
+if sys.version_info >= (3, 10):
+    from types import EllipsisType
+else:
+    from typing import Any as EllipsisType
+
+import numpy as np
+
+from ._base import FoamDict
+
+Entries = Dict[
+    Tuple[str, ...],
+    Tuple[int, Union[FoamDict.Data, EllipsisType, "Lazy"], int],
+]
+
+
+_T = TypeVar("_T")
+
+
+class ParseError(Exception):
+    pass
+
+
+class _EndOfList(ParseError):
+    pass
+
+
+_SKIP = re.compile(
+    rb"(?:\s+|//(?:\\\n|[^\n])*|/\*(?:[^*]|\*(?!/))*\*/|#include[^\n]*)*"
+)
+_NUMBER = re.compile(
+    rb"(?:([+-]?(?:(?:\d+\.\d*|\.\d+)(?:[eE][+-]?\d+)?|\d+[eE][+-]?\d+))|([+-]?\d+))"
+    rb"(?=[\s;(){}\[\]/\"]|\Z)"
+)
+_COUNT = re.compile(rb"\d+(?=[\s({/]|\Z)")
+_NUMBER_LIST = re.compile(
+    rb"\(\s*((?:[+-]?(?:\d+\.?\d*|\.\d+)(?:[eE][+-]?\d+)?"
+    rb"(?:\s+[+-]?(?:\d+\.?\d*|\.\d+)(?:[eE][+-]?\d+)?)*)?)\s*\)"
+)
+_WORD = re.compile(rb"[^\s;(){}\"]+")
+_STRING = re.compile(rb'"[^"\n]*"')
+_LIST_PREFIX = re.compile(rb"List\s*<\s*(\w+)\s*>")
+_TENSOR_LIST_END = re.compile(rb"\)\s*\)")
+_PARENS_TO_SPACES = bytes.maketrans(b"()", b"  ")
+_STRUCTURE = re.compile(rb'[;(){}\[\]"/#]|List\s*<')
+_SIMPLE_LIST = re.compile(rb'\([^(){}"/#]*(?:\([^(){}"/#]*\)[^(){}"/#]*)*\)')
+
+_ARCH_ORDER = re.compile(r"\b([LM])SB\b")
+_ARCH_LABEL = re.compile(r"label=(\d+)")
+_ARCH_SCALAR = re.compile(r"scalar=(\d+)")
+
+# Element types of the standalone data of binary files, by header class
+_STANDALONE_KINDS = {
+    "labelList": "label",
+    "faceCompactList": "label",
+    "boolList": "bool",
+    "scalarField": "scalar",
+    "vectorField": "vector",
+    "symmTensorField": "symmTensor",
+    "tensorField": "tensor",
+}
+
+# Matched against decoded words: slices of decompressed contents, which are
+# a bytearray, are unhashable
+_TRUE = frozenset(("yes", "true", "on", "y", "t"))
+_FALSE = frozenset(("no", "false", "off", "n", "f"))
+
+_ELSIZES = {
+    "scalar": 1,
+    "sphericalTensor": 1,
+    "vector": 3,
+    "symmTensor": 6,
+    "tensor": 9,
+}
+
+_LPAREN = ord("(")
+_RPAREN = ord(")")
+_LBRACE = ord("{")
+_RBRACE = ord("}")
+_LBRACKET = ord("[")
+_RBRACKET = ord("]")
+_SEMICOLON = ord(";")
+_QUOTE = ord('"')
+_SLASH = ord("/")
+_HASH = ord("#")
+_L = ord("L")
+
+_NOT_DATA = frozenset((_SEMICOLON, _LBRACE, _RBRACE, _RPAREN, _RBRACKET))
+_OPENING = frozenset((_LPAREN, _LBRACE, _LBRACKET))
+_CLOSING = frozenset((_RPAREN, _RBRACE, _RBRACKET))
+_TOKEN_END = frozenset((*b" \t\n\r\f\v", *_OPENING, *_CLOSING, _SEMICOLON, _QUOTE))
+# Directives other than #include (which is skipped) are not supported
+_NOT_WORD_START = frozenset((*_NOT_DATA, _LPAREN, _LBRACKET, _QUOTE, _SLASH, _HASH))
+
+
+def arch_dtypes(arch: Optional[str]) -> Tuple["np.dtype[Any]", "np.dtype[Any]"]:
+    # Label and scalar types of binary data for a FoamFile arch entry, such
+    # as "LSB;label=32;scalar=64". Without one, labels are 32-bit and
+    # scalars 64-bit, in native byte order
+    order = _ARCH_ORDER.search(arch) if arch is not None else None
+    label = _ARCH_LABEL.search(arch) if arch is not None else None
+    scalar = _ARCH_SCALAR.search(arch) if arch is not None else None
+    prefix = {"L": "<", "M": ">"}[order.group(1)] if order else "="
+    label_size = int(label.group(1)) // 8 if label else 4
+    scalar_size = int(scalar.group(1)) // 8 if scalar else 8
+    return np.dtype(f"{prefix}i{label_size}"), np.dtype(f"{prefix}f{scalar_size}")
+
+
+def _to_number(token: bytes) -> Union[int, float]:
+    if token.lstrip(b"+-").isdigit():
+        return int(token)
+    return float(token)
+
+
+class Lazy:
+    # The value of an entry that has been located but not parsed yet, which
+    # extends from start to end (not counting whitespace and comments).
+    # contents is kept so that the value can still be parsed after edits
+    __slots__ = ("arch", "binary", "contents", "end", "keywords", "start")
+
+    def __init__(
+        self,
+        contents: bytes,
+        keywords: Tuple[str, ...],
+        start: int,
+        end: int,
+        *,
+        binary: bool = False,
+        arch: Optional[str] = None,
+    ) -> None:
+        self.contents = contents
+        self.keywords = keywords
+        self.start = start
+        self.end = end
+        self.binary = binary
+        self.arch = arch
+
+    def load(self) -> FoamDict.Data:
+        parser = _Parser(self.contents, binary=self.binary, arch=self.arch)
+        values, end = parser._data(self.start)
+        if parser._skip(end) != self.end:
+            raise parser._error("unexpected data", end)
+        return tuple(values) if len(values) > 1 else values[0] if values else ""
+
+
+class _Parser:
+    def __init__(
+        self,
+        contents: bytes,
+        *,
+        binary: bool = False,
+        arch: Optional[str] = None,
+        lazy: bool = False,
+    ) -> None:
+        self._contents = contents
+        self._len = len(contents)
+        self._binary = binary
+        self._lazy = lazy
+        self._class: Optional[str] = None
+        self._set_arch(arch)
+
+    def _set_arch(self, arch: Optional[str]) -> None:
+        self._arch = arch
+        label, self._scalar_dtype = arch_dtypes(arch)
+        self._list_dtypes = {"label": label, "bool": np.dtype(bool)}
+
+    def _skip(self, pos: int) -> int:
+        m = _SKIP.match(self._contents, pos)
+        assert m is not None
+        return m.end()
+
+    def _error(self, msg: str, pos: int) -> ParseError:
+        return ParseError(f"{msg} at position {pos}")
+
+    def _expect(self, char: int, pos: int) -> int:
+        if pos >= self._len or self._contents[pos] != char:
+            raise self._error(f"expected {chr(char)!r}", pos)
+        return pos + 1
+
+    def parse_file(self) -> Entries:
+        entries: Entries = {}
+        standalone = False
+
+        pos = self._skip(0)
+        while pos < self._len:
+            try:
+                pos = self._keyword_entry(pos, (), entries)
+            except ParseError:
+                if standalone:
+                    raise
+                standalone = True
+                end = self._skip_standalone_list(pos)
+                if end is not None:
+                    entries[("",)] = (
+                        pos,
+                        Lazy(
+                            self._contents,
+                            ("",),
+                            pos,
+                            self._len,
+                            binary=self._binary,
+                            arch=self._arch,
+                        ),
+                        end,
+                    )
+                    return entries
+
+                values, end = self._standalone_data(pos)
+                if not values:
+                    raise
+                entries[("",)] = (
+                    pos,
+                    tuple(values) if len(values) > 1 else values[0],
+                    end,
+                )
+                pos = end
+
+            if ("FoamFile", "format") in entries:
+                self._binary = entries[("FoamFile", "format")][1] == "binary"
+            if ("FoamFile", "class") in entries:
+                cls = entries[("FoamFile", "class")][1]
+                self._class = cls if isinstance(cls, str) else None
+            if ("FoamFile", "arch") in entries:
+                arch = entries[("FoamFile", "arch")][1]
+                if isinstance(arch, str) and arch != self._arch:
+                    self._set_arch(arch)
+
+            pos = self._skip(pos)
+
+        return entries
+
+    def _keyword(self, pos: int) -> Tuple[str, int]:
+        if pos >= self._len:
+            raise self._error("expected keyword", pos)
+
+        if self._contents[pos] == _QUOTE:
+            m = _STRING.match(self._contents, pos)
+            if m is None:
+                raise self._error("unterminated string", pos)
+            return m.group().decode("latin-1"), m.end()
+
+        if self._contents[pos] == _HASH:
+            raise self._error("unsupported directive", pos)
+
+        if _NUMBER.match(self._contents, pos) is not None:
+            raise self._error("expected keyword", pos)
+
+        return self._word(pos)
+
+    def _word(self, pos: int) -> Tuple[str, int]:
+        contents = self._contents
+        start = pos
+
+        if pos >= self._len or contents[pos] in _NOT_WORD_START:
+            raise self._error("expected word", pos)
+
+        if contents[pos : pos + 2] == b"${":
+            end = contents.find(b"}", pos)
+            if end == -1:
+                raise self._error("unterminated variable", pos)
+            pos = end + 1
+
+        depth = 0
+        while True:
+            m = _WORD.match(contents, pos)
+            if m is not None:
+                pos = m.end()
+            if pos < self._len and contents[pos] == _LPAREN:
+                depth += 1
+                pos += 1
+            elif pos < self._len and contents[pos] == _RPAREN and depth > 0:
+                depth -= 1
+                pos += 1
+            else:
+                break
+
+        if pos == start:
+            raise self._error("expected word", pos)
+
+        return contents[start:pos].decode("latin-1"), pos
+
+    def _keyword_entry(
+        self, pos: int, keywords: Tuple[str, ...], entries: Entries
+    ) -> int:
+        start = pos
+        keyword, pos = self._keyword(pos)
+        keywords = (*keywords, keyword)
+
+        pos = self._skip(pos)
+
+        if pos < self._len and self._contents[pos] == _LBRACE:
+            entries[keywords] = (start, ..., -1)
+            pos = self._skip(pos + 1)
+            while pos >= self._len or self._contents[pos] != _RBRACE:
+                pos = self._keyword_entry(pos, keywords, entries)
+                pos = self._skip(pos)
+            entries[keywords] = (start, ..., pos + 1)
+            return pos + 1
+
+        # The header is always parsed, as it determines how the rest of the
+        # file is read
+        if self._lazy and keywords[0] != "FoamFile":
+            try:
+                end = self._skip_data(pos)
+            except ParseError:
+                pass
+            else:
+                entries[keywords] = (
+                    start,
+                    Lazy(
+                        self._contents,
+                        keywords,
+                        pos,
+                        end,
+                        binary=self._binary,
+                        arch=self._arch,
+                    ),
+                    end + 1,
+                )
+                return end + 1
+
+        values, end = self._data(pos)
+        pos = self._expect(_SEMICOLON, self._skip(end))
+
+        entries[keywords] = (
+            start,
+            tuple(values) if len(values) > 1 else values[0] if values else "",
+            pos,
+        )
+        return pos
+
+    def _skip_data(self, pos: int) -> int:
+        # Finds the ';' that ends the data starting at pos by matching
+        # brackets, skipping over strings and comments, without parsing
+        contents = self._contents
+        depth = 0
+        while True:
+            m = _STRUCTURE.search(contents, pos)
+            if m is None:
+                raise self._error("expected ';'", self._len)
+            pos = m.start()
+            c = contents[pos]
+
+            if c == _SEMICOLON:
+                if depth == 0:
+                    return pos
+            elif c == _LPAREN:
+                if not self._binary:
+                    # Lists without strings or comments, nested up to once
+                    m = _SIMPLE_LIST.match(contents, pos)
+                    if m is not None:
+                        pos = m.end()
+                        continue
+                depth += 1
+            elif c in _OPENING:
+                depth += 1
+            elif c in _CLOSING:
+                if depth == 0:
+                    raise self._error(f"unexpected {chr(c)!r}", pos)
+                depth -= 1
+            elif c == _QUOTE:
+                m = _STRING.match(contents, pos)
+                if m is None:
+                    raise self._error("unterminated string", pos)
+                pos = m.end()
+                continue
+            elif contents[pos - 1] not in _TOKEN_END:
+                pass
+            elif c == _L:
+                end = self._skip_counted_list(pos)
+                if end is not None:
+                    pos = end
+                    continue
+            else:
+                # '/' or '#': may start a comment or #include
+                end = self._skip(pos)
+                if end > pos:
+                    pos = end
+                    continue
+
+            pos += 1
+
+    def _skip_counted_list(self, pos: int) -> Optional[int]:
+        # Jumps over a List<T> N(...) using its count and element type.
+        # Returns None if the list must be scanned like any other data
+        contents = self._contents
+
+        m = _LIST_PREFIX.match(contents, pos)
+        if m is None:
+            return None
+        kind = m.group(1).decode("latin-1")
+
+        pos = self._skip(m.end())
+        m = _COUNT.match(contents, pos)
+        if m is None:
+            return None
+        count = int(m.group())
+
+        pos = self._skip(m.end())
+        if pos >= self._len or contents[pos] != _LPAREN:
+            return None
+        start = pos + 1
+
+        if self._binary:
+            if kind in _ELSIZES:
+                end = start + count * _ELSIZES[kind] * self._scalar_dtype.itemsize
+            elif kind in self._list_dtypes:
+                end = start + count * self._list_dtypes[kind].itemsize
+            else:
+                raise self._error("unsupported binary list type", pos)
+            if end >= self._len or contents[end] != _RPAREN:
+                raise self._error("truncated binary list", start)
+        elif kind not in _ELSIZES:
+            return None
+        else:
+            end = self._ascii_field_end(start, _ELSIZES[kind])
+            if end == -1:
+                return None
+
+        return end + 1
+
+    def _dict_entry(self, pos: int) -> Tuple[Dict[str, FoamDict.Data], int]:
+        keyword, pos = self._keyword(pos)
+
+        pos = self._skip(pos)
+
+        if pos < self._len and self._contents[pos] == _LBRACE:
+            ret: Dict[str, FoamDict.Data] = {}
+            pos = self._skip(pos + 1)
+            while pos >= self._len or self._contents[pos] != _RBRACE:
+                entry, pos = self._dict_entry(pos)
+                ret.update(entry)
+                pos = self._skip(pos)
+            return {keyword: ret}, pos + 1
+
+        values, end = self._data(pos)
+        pos = self._skip(end)
+        if pos < self._len and self._contents[pos] == _RPAREN:
+            raise _EndOfList(f"unexpected ')' at position {pos}")
+        pos = self._expect(_SEMICOLON, pos)
+
+        return {
+            keyword: tuple(values) if len(values) > 1 else values[0] if values else ""
+        }, pos
+
+    def _skip_standalone_list(self, pos: int) -> Optional[int]:
+        # In lazy mode, standalone data that consists of a single ASCII list
+        # that ends the file (e.g. that of a mesh file) is left unparsed.
+        # Returns the end of the list, or None if the data must be parsed
+        if not self._lazy or self._binary:
+            return None
+
+        m = _COUNT.match(self._contents, pos)
+        if m is not None:
+            pos = self._skip(m.end())
+
+        m = _SIMPLE_LIST.match(self._contents, pos)
+        if m is None or self._skip(m.end()) != self._len:
+            return None
+
+        return m.end()
+
+    def _standalone_data(self, pos: int) -> Tuple[List[FoamDict.Data], int]:
+        # In binary files, standalone data such as that of polyMesh/owner
+        # (a labelList) or polyMesh/faces (a faceCompactList, i.e. a list
+        # of offsets followed by a list of labels) consists of binary lists
+        # with no List<...> prefix; their type is given by the class
+        kind = _STANDALONE_KINDS.get(self._class or "")
+        if self._binary and kind is not None:
+            values: List[FoamDict.Data] = []
+            try:
+                while True:
+                    value, end = self._binary_list(pos, kind=kind)
+                    values.append(value)
+                    pos = self._skip(end)
+                    if _COUNT.match(self._contents, pos) is None:
+                        return values, end
+            except ParseError:
+                pass
+
+        return self._data(pos)
+
+    def _data(self, pos: int) -> Tuple[List[FoamDict.Data], int]:
+        values: List[FoamDict.Data] = []
+        end = pos
+        while pos < self._len and self._contents[pos] not in _NOT_DATA:
+            value, end = self._data_entry(pos)
+            values.append(value)
+            pos = self._skip(end)
+        return values, end
+
+    def _data_entry(self, pos: int) -> Tuple[FoamDict.Data, int]:
+        contents = self._contents
+        c = contents[pos]
+
+        if c == _LPAREN:
+            return self._list(pos, self._data_entry, dict_entries=True)
+
+        if c == _LBRACKET:
+            dimensions, pos = self._dimensions(pos)
+            try:
+                value, end = self._tensor(self._skip(pos))
+            except ParseError:
+                return dimensions, pos
+            return FoamDict.Dimensioned(value, dimensions), end
+
+        if c == _QUOTE:
+            m = _STRING.match(contents, pos)
+            if m is None:
+                raise self._error("unterminated string", pos)
+            return m.group().decode("latin-1"), m.end()
+
+        m = _NUMBER.match(contents, pos)
+        if m is not None:
+            if m.group(2) is not None and m.group(2).isdigit():
+                after = self._skip(m.end())
+                if after < self._len and contents[after] in (_LPAREN, _LBRACE):
+                    return self._list(pos, self._data_entry, dict_entries=True)
+            return _to_number(m.group()), m.end()
+
+        if c == _SLASH:
+            raise self._error("unexpected '/'", pos)
+
+        if _LIST_PREFIX.match(contents, pos) is not None:
+            if self._binary:
+                try:
+                    return self._binary_list(pos)
+                except ParseError:
+                    pass
+            return self._list(pos, self._data_entry, dict_entries=True)
+
+        word, pos = self._word(pos)
+
+        if word == "uniform":
+            try:
+                return self._tensor(self._skip(pos))
+            except ParseError:
+                pass
+
+        elif word == "nonuniform":
+            try:
+                return self._field(self._skip(pos))
+            except ParseError:
+                pass
+
+        after = self._skip(pos)
+        if after < self._len and contents[after] == _LBRACKET:
+            try:
+                dimensions, end = self._dimensions(after)
+                value, end = self._tensor(self._skip(end))
+            except ParseError:
+                pass
+            else:
+                return FoamDict.Dimensioned(value, dimensions, word), end
+
+        if word in _TRUE:
+            return True, pos
+        if word in _FALSE:
+            return False, pos
+
+        return word, pos
+
+    def _dimensions(self, pos: int) -> Tuple[FoamDict.DimensionSet, int]:
+        pos = self._expect(_LBRACKET, pos)
+        values = []
+        for _ in range(7):
+            m = _NUMBER.match(self._contents, self._skip(pos))
+            if m is None:
+                raise self._error("expected number", pos)
+            values.append(_to_number(m.group()))
+            pos = m.end()
+        pos = self._expect(_RBRACKET, self._skip(pos))
+        return FoamDict.DimensionSet(*values), pos
+
+    def _number(self, pos: int) -> Tuple[Union[int, float], int]:
+        m = _NUMBER.match(self._contents, pos)
+        if m is None:
+            raise self._error("expected number", pos)
+        return _to_number(m.group()), m.end()
+
+    def _tensor(
+        self, pos: int
+    ) -> Tuple[Union[int, float, List[Union[int, float]]], int]:
+        try:
+            return self._list(pos, self._number)
+        except ParseError:
+            return self._number(pos)
+
+    def _field(self, pos: int) -> Tuple[FoamDict.Data, int]:
+        if self._binary:
+            try:
+                return self._binary_field(pos)
+            except ParseError:
+                pass
+
+        try:
+            return self._ascii_field(pos)
+        except ParseError:
+            pass
+
+        try:
+            return self._list(pos, self._tensor)
+        except ParseError:
+            if self._binary:
+                raise
+            return self._binary_field(pos)
+
+    def _field_header(self, pos: int) -> Tuple[int, int, int]:
+        m = _LIST_PREFIX.match(self._contents, pos)
+        if m is None:
+            raise self._error("expected List<...>", pos)
+        try:
+            elsize = _ELSIZES[m.group(1).decode("latin-1")]
+        except KeyError:
+            raise self._error("unsupported field type", pos) from None
+
+        pos = self._skip(m.end())
+        m = _COUNT.match(self._contents, pos)
+        if m is None:
+            raise self._error("expected count", pos)
+        count = int(m.group())
+
+        return elsize, count, self._expect(_LPAREN, self._skip(m.end()))
+
+    def _ascii_field_end(self, start: int, elsize: int) -> int:
+        # Position of the ')' that closes a numeric list, or -1
+        contents = self._contents
+
+        if elsize == 1:
+            end = contents.find(b")", start)
+        elif contents[self._skip(start) : self._skip(start) + 1] == b")":
+            end = self._skip(start)
+        else:
+            m = _TENSOR_LIST_END.search(contents, start)
+            end = m.end() - 1 if m is not None else -1
+
+        if end != -1 and contents.find(b"/", start, end) != -1:
+            return -1
+
+        return end
+
+    def _ascii_field(self, pos: int) -> Tuple[FoamDict.Data, int]:
+        contents = self._contents
+        elsize, count, start = self._field_header(pos)
+
+        end = self._ascii_field_end(start, elsize)
+        if end == -1:
+            raise self._error("expected numeric list", start)
+
+        data = bytes(contents[start:end])
+        if elsize != 1:
+            data = data.translate(_PARENS_TO_SPACES)
+
+        with warnings.catch_warnings():
+            warnings.simplefilter("ignore", DeprecationWarning)
+            try:
+                arr = np.fromstring(data, sep=" ")  # type: ignore [call-overload]
+            except ValueError:
+                raise self._error("expected numeric list", start) from None
+
+        if arr.size != count * elsize:
+            raise self._error("wrong number of values in numeric list", start)
+
+        if elsize != 1:
+            arr = arr.reshape(-1, elsize)
+
+        arr.flags.writeable = False
+
+        return arr, end + 1
+
+    def _binary_field(self, pos: int) -> Tuple[FoamDict.Data, int]:
+        elsize, count, start = self._field_header(pos)
+
+        end = start + count * elsize * self._scalar_dtype.itemsize
+        if end >= self._len or self._contents[end] != _RPAREN:
+            raise self._error("truncated binary field", start)
+
+        arr = np.frombuffer(
+            self._contents,
+            dtype=self._scalar_dtype,
+            count=count * elsize,
+            offset=start,
+        )
+        arr.flags.writeable = False
+
+        if elsize != 1:
+            arr = arr.reshape(-1, elsize)
+
+        return arr, end + 1
+
+    def _binary_list(
+        self, pos: int, *, kind: Optional[str] = None
+    ) -> Tuple[FoamDict.Data, int]:
+        # A binary List<label> or List<bool>; with kind, also a list of
+        # that type with no List<...> prefix
+        contents = self._contents
+
+        m = _LIST_PREFIX.match(contents, pos)
+        if m is not None:
+            kind = m.group(1).decode("latin-1")
+            pos = self._skip(m.end())
+        elif kind is None:
+            raise self._error("expected List<...>", pos)
+
+        elsize = _ELSIZES.get(kind, 1)
+        if kind in _ELSIZES:
+            dtype = self._scalar_dtype
+        elif kind in self._list_dtypes:
+            dtype = self._list_dtypes[kind]
+        else:
+            raise self._error("unsupported list type", pos)
+
+        m = _COUNT.match(contents, pos)
+        if m is None:
+            raise self._error("expected count", pos)
+        count = int(m.group())
+        start = self._expect(_LPAREN, self._skip(m.end()))
+
+        end = start + count * elsize * dtype.itemsize
+        if end >= self._len or contents[end] != _RPAREN:
+            raise self._error("truncated binary list", start)
+
+        arr = np.frombuffer(contents, dtype=dtype, count=count * elsize, offset=start)
+        arr.flags.writeable = False
+
+        if elsize != 1:
+            arr = arr.reshape(-1, elsize)
+
+        return arr, end + 1
+
+    def _list(
+        self,
+        pos: int,
+        entry: Callable[[int], Tuple[_T, int]],
+        *,
+        dict_entries: bool = False,
+    ) -> Tuple[List[_T], int]:
+        contents = self._contents
+
+        m = _LIST_PREFIX.match(contents, pos)
+        if m is not None:
+            pos = self._skip(m.end())
+
+        count: Optional[int] = None
+        m = _COUNT.match(contents, pos)
+        if m is not None:
+            count = int(m.group())
+            pos = self._skip(m.end())
+
+        if pos < self._len and contents[pos] == _LBRACE:
+            if count is None:
+                raise self._error("expected count before '{'", pos)
+            value, pos = entry(self._skip(pos + 1))
+            pos = self._expect(_RBRACE, self._skip(pos))
+            return [value] * count, pos
+
+        m = _NUMBER_LIST.match(contents, pos)
+        if m is not None:
+            return cast(List[_T], [_to_number(t) for t in m.group(1).split()]), m.end()
+
+        pos = self._skip(self._expect(_LPAREN, pos))
+
+        values: List[_T] = []
+        while True:
+            if pos >= self._len:
+                raise self._error("expected ')'", pos)
+
+            c = contents[pos]
+            if c == _RPAREN:
+                break
+
+            if (
+                dict_entries
+                and c != _LPAREN
+                and c != _LBRACKET
+                and _NUMBER.match(contents, pos) is None
+            ):
+                try:
+                    value, pos = cast(Tuple[_T, int], self._dict_entry(pos))
+                except _EndOfList:
+                    dict_entries = False
+                    value, pos = entry(pos)
+                except ParseError:
+                    value, pos = entry(pos)
+            else:
+                value, pos = entry(pos)
+
+            values.append(value)
+            pos = self._skip(pos)
+
+        return values, pos + 1
+
+
+def parse(
+    contents: bytes,
+    *,
+    binary: bool = False,
+    arch: Optional[str] = None,
+    lazy: bool = False,
+) -> Entries:
+    return _Parser(contents, binary=binary, arch=arch, lazy=lazy).parse_file()
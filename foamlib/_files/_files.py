@@ -1,19 +1,28 @@
 import sys
-from typing import Any, Tuple, Union, cast
+from copy import deepcopy
+from typing import Any, Optional, Tuple, Union, cast
 
 if sys.version_info >= (3, 9):
     from collections.abc import Iterator, Mapping, MutableMapping, Sequence
 else:
     from typing import Iterator, Mapping, MutableMapping, Sequence
 
+import numpy as np
+
 from ._base import FoamDict
 from ._io import FoamFileIO
 from ._serialization import Kind, dumpb
 
-try:
-    import numpy as np
-except ModuleNotFoundError:
-    pass
+
+def _copy(data: FoamDict.Data) -> FoamDict.Data:
+    # Arrays are read-only, so they are returned as they are instead of copied
+    if isinstance(data, np.ndarray):
+        return data
+    return deepcopy(data)
+
+
+def _copy_dict(d: FoamDict._Dict) -> FoamDict._Dict:
+    return {k: _copy_dict(v) if isinstance(v, dict) else _copy(v) for k, v in d.items()}
 
 
 class FoamFile(
@@ -29,6 +38,19 @@ class FoamFile(
     Use as a mutable mapping (i.e., like a dict) to access and modify entries.
 
     Use as a context manager to make multiple changes to the file while saving all changes only once at the end.
+
+    Nonuniform fields are returned as read-only NumPy arrays. Call `.copy()` on them to get an array that can be modified.
+
+    In binary files, label and bool lists (including the contents of mesh files such as `owner` and `faces`) are also returned as NumPy arrays. Binary data is read and written with the byte order and the label and scalar sizes given by the `arch` header entry (e.g. `"LSB;label=32;scalar=32"` for single precision), defaulting to native byte order, 32-bit labels and 64-bit scalars.
+
+    Files with a .gz extension are transparently decompressed and compressed. Set `FoamFile.compresslevel` to change the compression level used for writing them.
+
+    Set `FoamFile.cache_dir` to cache parsed files on disk, so that other processes can open them without parsing them again.
+
+    :param path: The path to the file.
+    :param trust_cache: If True, read the file only once and assume that it is not modified afterwards by anything other than this object. Useful for post-processing scripts that never write to the case. If False (the default), changes on disk are detected by comparing the file's modification time, size and inode before every access.
+    :param memory_map: If True, map the file into memory instead of reading it. Binary fields are then returned as arrays backed by the file on disk that are only loaded as their values are accessed, so that metadata such as boundary types can be read from very large field files without loading them. Writes replace the file instead of modifying it in place. Compressed files are always read into memory.
+    :param write_precision: Number of significant digits used when writing nonuniform fields in ASCII format and NumPy arrays of floats, with the same meaning as `writePrecision` in a controlDict. If None (the default), values are written with as many digits as needed to be read back exactly.
     """
 
     class SubDict(
@@ -78,15 +100,8 @@ class FoamFile(
 
         def as_dict(self) -> FoamDict._Dict:
             """Return a nested dict representation of the dictionary."""
-            ret = self._file.as_dict()
-
-            for k in self._keywords:
-                assert isinstance(ret, dict)
-                v = ret[k]
-                assert isinstance(v, dict)
-                ret = v
-
-            return ret
+            _, parsed = self._file._read()
+            return _copy_dict(parsed.as_dict(self._keywords))
 
     def __getitem__(
         self, keywords: Union[str, Tuple[str, ...]]
@@ -101,12 +116,17 @@ class FoamFile(
         if value is ...:
             return FoamFile.SubDict(self, keywords)
         else:
-            return value
+            return _copy(value)
 
     @property
     def _binary(self) -> bool:
         return self.get(("FoamFile", "format"), None) == "binary"
 
+    @property
+    def _arch(self) -> Optional[str]:
+        arch = self.get(("FoamFile", "arch"), None)
+        return arch if isinstance(arch, str) else None
+
     def __setitem__(
         self,
         keywords: Union[str, Tuple[str, ...]],
@@ -118,55 +138,76 @@ class FoamFile(
         if not isinstance(keywords, tuple):
             keywords = (keywords,)
 
+        self._splice(
+            keywords,
+            b"\n"
+            + self._dumpb_entry(keywords, data, binary=self._binary, arch=self._arch)
+            + b"\n",
+            missing_ok=True,
+        )
+
+    def _dumpb_entry(
+        self,
+        keywords: Tuple[str, ...],
+        data: "FoamFile._SetData",
+        *,
+        binary: bool,
+        arch: Optional[str],
+    ) -> bytes:
+        if isinstance(data, Mapping):
+            if isinstance(data, FoamDict):
+                data = data.as_dict()
+
+            return (
+                dumpb(keywords[-1])
+                + b"\n{\n"
+                + b"\n".join(
+                    self._dumpb_entry((*keywords, k), v, binary=binary, arch=arch)
+                    for k, v in data.items()
+                )
+                + b"\n}"
+            )
+
         kind = Kind.DEFAULT
         if keywords == ("internalField",) or (
             len(keywords) == 3
             and keywords[0] == "boundaryField"
             and keywords[2] == "value"
         ):
-            kind = Kind.BINARY_FIELD if self._binary else Kind.FIELD
+            kind = Kind.BINARY_FIELD if binary else Kind.FIELD
         elif keywords == ("dimensions",):
             kind = Kind.DIMENSIONS
 
-        contents, parsed = self._read()
-
-        if isinstance(data, Mapping):
-            with self:
-                if isinstance(data, FoamDict):
-                    data = data.as_dict()
-
-                start, end = parsed.entry_location(keywords, missing_ok=True)
-
-                self._write(
-                    contents[:start]
-                    + b"\n"
-                    + dumpb({keywords[-1]: {}})
-                    + b"\n"
-                    + contents[end:]
-                )
-
-                for k, v in data.items():
-                    self[(*keywords, k)] = v
-        else:
-            start, end = parsed.entry_location(keywords, missing_ok=True)
-
-            self._write(
-                contents[:start]
-                + b"\n"
-                + dumpb({keywords[-1]: data}, kind=kind)
-                + b"\n"
-                + contents[end:]
-            )
+        return dumpb(
+            {keywords[-1]: data},
+            kind=kind,
+            precision=self.write_precision,
+            arch=arch,
+        )
 
     def __delitem__(self, keywords: Union[str, Tuple[str, ...]]) -> None:
         if not isinstance(keywords, tuple):
             keywords = (keywords,)
 
+        self._splice(keywords, b"")
+
+    def _splice(
+        self, keywords: Tuple[str, ...], new: bytes, *, missing_ok: bool = False
+    ) -> None:
         contents, parsed = self._read()
 
-        start, end = parsed.entry_location(keywords)
+        start, end = parsed.entry_location(keywords, missing_ok=missing_ok)
+        if start < 0:
+            start = end = max(len(contents) + start, 0)
+
+        # Patch the parsed entries instead of parsing the whole file again,
+        # except for changes to the header, which can affect how the rest
+        # of the file is parsed
+        patched = None
+        if keywords[0] != "FoamFile":
+            patched = parsed.patch(keywords, start, end, new)
 
-        self._write(contents[:start] + contents[end:])
+        self._write(contents[:start] + new + contents[end:], patched)
 
     def _iter(self, keywords: Union[str, Tuple[str, ...]] = ()) -> Iterator[str]:
         if not isinstance(keywords, tuple):
@@ -202,7 +243,7 @@ class FoamFile(
     def as_dict(self) -> FoamDict._Dict:
         """Return a nested dict representation of the file."""
         _, parsed = self._read()
-        return parsed.as_dict()
+        return _copy_dict(parsed.as_dict())
 
 
 class FoamFieldFile(FoamFile):
@@ -244,11 +285,15 @@ class FoamFieldFile(FoamFile):
         ]:
             """Alias of `self["value"]`."""
             ret = self["value"]
-            if not isinstance(ret, (int, float, Sequence)):
+            if not isinstance(ret, (int, float, Sequence, np.ndarray)):
                 raise TypeError("value is not a field")
             return cast(
                 Union[
-                    int, float, Sequence[Union[int, float, Sequence[Union[int, float]]]]
+                    int,
+                    float,
+                    Sequence[Union[int, float, Sequence[Union[int, float]]]],
+                    "np.ndarray[Tuple[int], np.dtype[np.generic]]",
+                    "np.ndarray[Tuple[int, int], np.dtype[np.generic]]",
                 ],
                 ret,
             )
@@ -312,9 +357,18 @@ class FoamFieldFile(FoamFile):
     ]:
         """Alias of `self["internalField"]`."""
         ret = self["internalField"]
-        if not isinstance(ret, (int, float, Sequence)):
+        if not isinstance(ret, (int, float, Sequence, np.ndarray)):
             raise TypeError("internalField is not a field")
-        return cast(Union[int, float, Sequence[Union[int, float]]], ret)
+        return cast(
+            Union[
+                int,
+                float,
+                Sequence[Union[int, float, Sequence[Union[int, float]]]],
+                "np.ndarray[Tuple[int], np.dtype[np.generic]]",
+                "np.ndarray[Tuple[int, int], np.dtype[np.generic]]",
+            ],
+            ret,
+        )
 
     @internal_field.setter
     def internal_field(
@@ -1,13 +1,21 @@
 import gzip
+import mmap
+import os
+import secrets
+import shutil
 import sys
-from copy import deepcopy
+from collections import deque
+from concurrent.futures import Future, ThreadPoolExecutor
 from pathlib import Path
 from types import TracebackType
 from typing import (
+    BinaryIO,
+    Deque,
     Optional,
     Tuple,
     Type,
     Union,
+    cast,
 )
 
 if sys.version_info >= (3, 11):
@@ -15,15 +23,49 @@ if sys.version_info >= (3, 11):
 else:
     from typing_extensions import Self
 
+from .._util import is_racy
+from . import _cache
 from ._parsing import Parsed
 
+_GZIP_CHUNK_SIZE = 2**20
+_GZIP_BLOCK_SIZE = 2**22
+# Maximum compression ratio of deflate
+_DEFLATE_MAX_RATIO = 1032
+
 
 class FoamFileIO:
-    def __init__(self, path: Union[str, Path]) -> None:
+    compresslevel = 9
+    """
+    Compression level (from 1 to 9) used when writing compressed (.gz) files. Lower levels are much faster and usually compress OpenFOAM files almost as well. Defaults to 9.
+    """
+
+    cache_dir: Optional[Union[str, Path]] = None
+    """
+    Directory in which to cache parsed files across processes, e.g. `~/.cache/foamlib`. Entries are keyed by the path, modification time, size and inode of each file, and nonuniform fields are stored as .npy files that are memory-mapped when loaded, so reopening a large unchanged file skips parsing entirely. Files modified less than 2 seconds ago are not cached, since a change within the timestamp resolution of the filesystem could otherwise go unnoticed. Entries are never removed automatically; the directory can be deleted at any time. Cache files that hold anything other than parsed file contents are ignored, so that they cannot be used to run code. If None (the default), parsed files are not cached on disk.
+    """
+
+    compression_threads = 1
+    """
+    Number of threads used when writing large compressed (.gz) files. If greater than 1, the contents are compressed in independent blocks in parallel and written as a sequence of concatenated gzip members, which OpenFOAM and any gzip reader decompress as a single stream. Defaults to 1.
+    """
+
+    def __init__(
+        self,
+        path: Union[str, Path],
+        *,
+        trust_cache: bool = False,
+        memory_map: bool = False,
+        write_precision: Optional[int] = None,
+    ) -> None:
         self.path = Path(path).absolute()
+        self.trust_cache = trust_cache
+        self.memory_map = memory_map
+        self.write_precision = write_precision
 
         self.__contents: Optional[bytes] = None
         self.__parsed: Optional[Parsed] = None
+        self.__stat: Optional[Tuple[int, int, int, int]] = None
+        self.__racy = False
         self.__defer_io = 0
         self.__dirty = False
 
@@ -40,38 +82,166 @@ class FoamFileIO:
         exc_tb: Optional[TracebackType],
     ) -> None:
         self.__defer_io -= 1
-        if self.__defer_io == 0 and self.__dirty:
-            assert self.__contents is not None
-            self._write(self.__contents)
-        assert not self.__dirty
-
-    def _read(self) -> Tuple[bytes, Parsed]:
-        if not self.__defer_io:
-            contents = self.path.read_bytes()
+        if self.__defer_io == 0:
+            if self.__dirty:
+                assert self.__contents is not None
+                self._write(self.__contents, self.__parsed)
+            assert not self.__dirty
 
-            if self.path.suffix == ".gz":
-                contents = gzip.decompress(contents)
+    def _stat(self) -> Tuple[int, int, int, int]:
+        st = self.path.stat()
+        return st.st_mtime_ns, st.st_ctime_ns, st.st_size, st.st_ino
 
-            if contents != self.__contents:
-                self.__contents = contents
-                self.__parsed = None
+    def _read(self) -> Tuple[bytes, Parsed]:
+        if not self.__defer_io and (self.__contents is None or not self.trust_cache):
+            stat = self._stat()
+
+            # A stat taken within the timestamp resolution of the last
+            # modification cannot rule out a later same-size change, so the
+            # contents are read and compared again in that case
+            if stat != self.__stat or self.__racy:
+                if self._mappable(stat[2]):
+                    contents = self._map()
+                elif self.path.suffix == ".gz":
+                    contents = self._decompress(stat[2])
+                else:
+                    contents = self.path.read_bytes()
+
+                if contents != self.__contents:
+                    self.__contents = contents
+                    self.__parsed = None
+
+                self.__stat = stat
+                self.__racy = is_racy(stat[0])
 
         assert self.__contents is not None
 
         if self.__parsed is None:
-            parsed = Parsed(self.__contents)
-            self.__parsed = parsed
-
-        return self.__contents, deepcopy(self.__parsed)
-
-    def _write(self, contents: bytes) -> None:
+            if self.cache_dir is not None and self.__stat and not self.__dirty:
+                cache_dir = Path(self.cache_dir).expanduser()
+                key = _cache.key(self.path, self.__stat)
+                self.__parsed = _cache.load(cache_dir, key)
+                if self.__parsed is None:
+                    self.__parsed = Parsed(self.__contents, lazy=True)
+                    # A file rewritten in place with the same size within
+                    # one timestamp tick would keep the same key
+                    if not self.__racy:
+                        _cache.store(cache_dir, key, self.__parsed)
+            else:
+                self.__parsed = Parsed(self.__contents, lazy=True)
+
+        return self.__contents, self.__parsed
+
+    def _mappable(self, size: int) -> bool:
+        return self.memory_map and self.path.suffix != ".gz" and size > 0
+
+    def _map(self) -> bytes:
+        with self.path.open("rb") as f:
+            # The mapping stays valid after the file is closed. It supports
+            # every bytes operation used by the parser, and arrays returned
+            # for binary fields are views into it
+            return cast(bytes, mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ))
+
+    def _decompress(self, size: int) -> bytes:
+        with self.path.open("rb") as f:
+            # The last four bytes of a gzip file hold the uncompressed size
+            # (of its last member, modulo 2**32); use it to size the buffer
+            # so that decompression needs no intermediate copies. The size
+            # is capped by what the file could hold, as it may be corrupt
+            if size >= 4:
+                f.seek(-4, os.SEEK_END)
+                isize = int.from_bytes(f.read(4), "little")
+                ret = bytearray(min(isize, size * _DEFLATE_MAX_RATIO))
+                f.seek(0)
+            else:
+                ret = bytearray()
+
+            n = 0
+            with gzip.GzipFile(fileobj=f) as g:
+                while n < len(ret):
+                    with memoryview(ret) as view:
+                        read = g.readinto(view[n : n + _GZIP_CHUNK_SIZE])
+                    if not read:
+                        del ret[n:]
+                        break
+                    n += read
+                else:
+                    while True:
+                        chunk = g.read(_GZIP_CHUNK_SIZE)
+                        if not chunk:
+                            break
+                        ret += chunk
+
+        # Like a mapping, a bytearray supports every bytes operation used by
+        # the parser except hashing, so the parser never hashes slices of
+        # the contents (words are decoded first)
+        return cast(bytes, ret)
+
+    def _dump(self, f: BinaryIO, contents: bytes) -> None:
+        if self.path.suffix != ".gz":
+            f.write(contents)
+        elif self.compression_threads > 1 and len(contents) > _GZIP_BLOCK_SIZE:
+            self._dump_parallel(f, contents)
+        else:
+            with gzip.GzipFile(
+                filename="", mode="wb", fileobj=f, compresslevel=self.compresslevel
+            ) as g, memoryview(contents) as view:
+                for i in range(0, len(view), _GZIP_CHUNK_SIZE):
+                    g.write(view[i : i + _GZIP_CHUNK_SIZE])
+
+    def _dump_parallel(self, f: BinaryIO, contents: bytes) -> None:
+        # zlib releases the GIL while compressing. Limit the number of
+        # blocks in flight so that memory use stays bounded
+        with ThreadPoolExecutor(self.compression_threads) as executor:
+            view = memoryview(contents)
+            pending: Deque[Future[bytes]] = deque()
+            for i in range(0, len(view), _GZIP_BLOCK_SIZE):
+                if len(pending) >= 2 * self.compression_threads:
+                    f.write(pending.popleft().result())
+                block = view[i : i + _GZIP_BLOCK_SIZE]
+                pending.append(
+                    executor.submit(gzip.compress, block, self.compresslevel)
+                )
+            while pending:
+                f.write(pending.popleft().result())
+
+    def _replace(self, contents: bytes) -> None:
+        # Truncating a file that is still mapped would invalidate arrays
+        # previously returned to the user, so write a new file instead. If
+        # the path is a symlink, replace its target rather than the link
+        path = Path(os.path.realpath(self.path))
+        fd, tmp = self._mktemp(path)
+        try:
+            with os.fdopen(fd, "wb") as f:
+                self._dump(f, contents)
+            if path.exists():
+                shutil.copymode(path, tmp)
+            os.replace(tmp, path)
+        except BaseException:
+            os.unlink(tmp)
+            raise
+
+    @staticmethod
+    def _mktemp(path: Path) -> Tuple[int, str]:
+        # Unlike tempfile.mkstemp (always 0600), create the file with the
+        # permissions a new file at path would get (0666 minus the umask)
+        while True:
+            tmp = str(path.parent / f".{path.name}.{secrets.token_hex(4)}")
+            try:
+                fd = os.open(tmp, os.O_WRONLY | os.O_CREAT | os.O_EXCL, 0o666)
+            except FileExistsError:
+                continue
+            return fd, tmp
+
+    def _write(self, contents: bytes, parsed: Optional[Parsed] = None) -> None:
         self.__contents = contents
-        self.__parsed = None
+        self.__parsed = parsed
         if not self.__defer_io:
-            if self.path.suffix == ".gz":
-                contents = gzip.compress(contents)
-
-            self.path.write_bytes(contents)
+            # Always replace the file, even when this instance does not map
+            # it: another one (e.g. a FoamMesh) may have
+            self._replace(contents)
+            self.__stat = self._stat()
+            self.__racy = is_racy(self.__stat[0])
             self.__dirty = False
         else:
             self.__dirty = True
@@ -1,6 +1,7 @@
-import array
+import re
 import sys
-from typing import Tuple, Union
+from copy import copy
+from typing import Any, Optional, Tuple, Union
 
 if sys.version_info >= (3, 9):
     from collections.abc import Iterator, Mapping, MutableMapping, Sequence
@@ -12,6 +13,7 @@ if sys.version_info >= (3, 10):
 else:
     from typing import Any as EllipsisType
 
+import numpy as np
 from pyparsing import (
     CharsNotIn,
     Dict,
@@ -22,6 +24,7 @@ from pyparsing import (
     Literal,
     Located,
     Opt,
+    ParseBaseException,
     ParserElement,
     ParseResults,
     QuotedString,
@@ -34,6 +37,7 @@ from pyparsing import (
 )
 
 from ._base import FoamDict
+from ._fast_parsing import Entries, Lazy, ParseError, arch_dtypes, parse
 
 
 def _list_of(entry: ParserElement) -> ParserElement:
@@ -76,6 +80,9 @@ def _keyword_entry_of(
 
 
 _binary_contents = Forward()
+# Type of the scalars of binary fields; set from the arch of the file before
+# each parse
+_scalar_dtype: "np.dtype[Any]" = np.dtype(float)
 
 
 def _binary_field_parse_action(tks: ParseResults) -> None:
@@ -93,19 +100,19 @@ def _binary_field_parse_action(tks: ParseResults) -> None:
 
     def unpack(
         tks: ParseResults,
-    ) -> Sequence[Union[Sequence[float], Sequence[Sequence[float]]]]:
+    ) -> Sequence["np.ndarray[Tuple[int, ...], np.dtype[np.float64]]"]:
         bytes_ = tks[0].encode("latin-1")
 
-        arr = array.array("d", bytes_)
+        arr = np.frombuffer(bytes_, dtype=_scalar_dtype)
 
         if elsize != 1:
-            all = [arr[i : i + elsize].tolist() for i in range(0, len(arr), elsize)]
-        else:
-            all = arr.tolist()
+            arr = arr.reshape(-1, elsize)
 
-        return [all]
+        return [arr]
 
-    _binary_contents <<= CharsNotIn(exact=count * elsize * 8).set_parse_action(unpack)
+    _binary_contents <<= CharsNotIn(
+        exact=count * elsize * _scalar_dtype.itemsize
+    ).set_parse_action(unpack)
 
     tks.clear()  # type: ignore [no-untyped-call]
 
@@ -125,6 +132,15 @@ _BINARY_FIELD = (
 )
 
 
+def _ascii_field_parse_action(
+    tks: ParseResults,
+) -> Sequence["np.ndarray[Tuple[int, ...], np.dtype[np.float64]]"]:
+    # Nonuniform fields are read as arrays, as by the fast parser
+    arr = np.array(tks[0], dtype=float)
+    arr.flags.writeable = False
+    return [arr]
+
+
 _SWITCH = (
     Keyword("yes") | Keyword("true") | Keyword("on") | Keyword("y") | Keyword("t")
 ).set_parse_action(lambda: True) | (
@@ -140,9 +156,12 @@ _DIMENSIONED = (Opt(_IDENTIFIER) + _DIMENSIONS + _TENSOR).set_parse_action(
 )
 _FIELD = (
     (Keyword("uniform").suppress() + _TENSOR)
-    | (Keyword("nonuniform").suppress() + _list_of(_TENSOR))
+    | (Keyword("nonuniform").suppress() + _list_of(_TENSOR)).set_parse_action(
+        _ascii_field_parse_action
+    )
     | _BINARY_FIELD
 )
+_ARCH = re.compile(rb'\barch\s+"([^"]*)"')
 _TOKEN = QuotedString('"', unquote_results=False) | _IDENTIFIER
 _DATA = Forward()
 _KEYWORD_ENTRY = Dict(Group(_keyword_entry_of(_TOKEN, _DATA)), asdict=True)
@@ -179,15 +198,95 @@ _FILE = (
 
 
 class Parsed(Mapping[Tuple[str, ...], Union[FoamDict.Data, EllipsisType]]):
-    def __init__(self, contents: bytes) -> None:
-        self._parsed: MutableMapping[
-            Tuple[str, ...],
-            Tuple[int, Union[FoamDict.Data, EllipsisType], int],
-        ] = {}
+    def __init__(
+        self,
+        contents: bytes,
+        *,
+        binary: bool = False,
+        arch: Optional[str] = None,
+        lazy: bool = False,
+    ) -> None:
+        # In lazy mode, only the structure of the file is scanned; values
+        # other than dictionaries are parsed when they are first accessed
+        self._parsed: Entries
+        try:
+            self._parsed = parse(contents, binary=binary, arch=arch, lazy=lazy)
+        except ParseError:
+            self._parsed = self._parse_with_pyparsing(contents, arch=arch)
+
+    def patch(
+        self,
+        keywords: Tuple[str, ...],
+        start: int,
+        end: int,
+        new: bytes,
+    ) -> Optional["Parsed"]:
+        # Only new is parsed (with the format and arch of the header);
+        # entries after the edit are shifted. new must be empty (deletion)
+        # or hold nothing but the entry for keywords
+        inserted: Entries = {}
+        if new:
+            arch = self.get(("FoamFile", "arch"))
+            try:
+                entries = Parsed(
+                    new,
+                    binary=self.get(("FoamFile", "format")) == "binary",
+                    arch=arch if isinstance(arch, str) else None,
+                    lazy=True,
+                )._parsed
+            except ParseBaseException:
+                return None
+            if (keywords[-1],) not in entries or any(
+                ks[0] != keywords[-1] for ks in entries
+            ):
+                return None
+            inserted = {
+                (*keywords[:-1], *ks): (s + start, data, e + start)
+                for ks, (s, data, e) in entries.items()
+            }
+
+        delta = len(new) - (end - start)
+
+        parsed: Entries = {}
+        for ks, (s, data, e) in self._parsed.items():
+            if ks[: len(keywords)] == keywords:
+                continue
+
+            if s >= end:
+                parsed.update(inserted)
+                inserted = {}
+                s += delta
+                e += delta
+            elif e > start:
+                e += delta
+
+            parsed[ks] = (s, data, e)
+
+        parsed.update(inserted)
+
+        ret = copy(self)
+        ret._parsed = parsed
+        return ret
+
+    @staticmethod
+    def _parse_with_pyparsing(
+        contents: bytes, *, arch: Optional[str] = None
+    ) -> Entries:
+        global _scalar_dtype
+
+        if arch is None:
+            # The header, which holds the arch, comes before any binary data
+            m = _ARCH.search(contents, 0, contents.find(b"}") + 1)
+            if m is not None:
+                arch = m.group(1).decode("latin-1")
+        _, _scalar_dtype = arch_dtypes(arch)
+
+        ret: Entries = {}
         for parse_result in _FILE.parse_string(
-            contents.decode("latin-1"), parse_all=True
+            bytes(contents).decode("latin-1"), parse_all=True
         ):
-            self._parsed.update(self._flatten_result(parse_result))
+            ret.update(Parsed._flatten_result(parse_result))
+        return ret
 
     @staticmethod
     def _flatten_result(
@@ -219,7 +318,17 @@ class Parsed(Mapping[Tuple[str, ...], Union[FoamDict.Data, EllipsisType]]):
         if isinstance(keywords, str):
             keywords = (keywords,)
 
-        _, data, _ = self._parsed[keywords]
+        start, data, end = self._parsed[keywords]
+        if isinstance(data, Lazy):
+            lazy = data
+            try:
+                data = lazy.load()
+            except ParseError:
+                data = self._parse_with_pyparsing(lazy.contents, arch=lazy.arch)[
+                    lazy.keywords
+                ][1]
+                assert not isinstance(data, Lazy)
+            self._parsed[keywords] = (start, data, end)
         return data
 
     def __contains__(self, keywords: object) -> bool:
@@ -250,17 +359,22 @@ class Parsed(Mapping[Tuple[str, ...], Union[FoamDict.Data, EllipsisType]]):
 
         return start, end
 
-    def as_dict(self) -> FoamDict._Dict:
+    def as_dict(self, keywords: Tuple[str, ...] = ()) -> FoamDict._Dict:
         ret: FoamDict._Dict = {}
-        for keywords, (_, data, _) in self._parsed.items():
+        for ks in list(self._parsed):
+            if len(ks) <= len(keywords) or ks[: len(keywords)] != keywords:
+                continue
+
+            data = self[ks]
+
             r = ret
-            for k in keywords[:-1]:
+            for k in ks[len(keywords) : -1]:
                 assert isinstance(r, dict)
                 v = r[k]
                 assert isinstance(v, dict)
                 r = v
 
             assert isinstance(r, dict)
-            r[keywords[-1]] = {} if data is ... else data
+            r[ks[-1]] = {} if data is ... else data
 
         return ret
@@ -2,21 +2,18 @@ import array
 import itertools
 import sys
 from enum import Enum, auto
+from typing import Any, Optional
 
 if sys.version_info >= (3, 9):
     from collections.abc import Mapping
 else:
     from typing import Mapping
 
+import numpy as np
+
 from .._util import is_sequence
 from ._base import FoamDict
-
-try:
-    import numpy as np
-
-    numpy = True
-except ModuleNotFoundError:
-    numpy = False
+from ._fast_parsing import arch_dtypes
 
 
 class Kind(Enum):
@@ -27,18 +24,100 @@ class Kind(Enum):
     DIMENSIONS = auto()
 
 
+_TENSOR_KINDS = {1: b"scalar", 3: b"vector", 6: b"symmTensor", 9: b"tensor"}
+_CHUNK_SIZE = 2**16
+
+
+def _is_nonuniform_field(data: "np.ndarray[Any, Any]") -> bool:
+    if data.dtype.kind not in "iuf":
+        return False
+    if data.ndim == 1:
+        return len(data) > 0 and len(data) not in (3, 6, 9)
+    return data.ndim == 2 and len(data) > 0 and data.shape[1] in (3, 6, 9)
+
+
+def _dumpb_ascii_values(
+    data: "np.ndarray[Any, Any]", *, precision: Optional[int] = None
+) -> bytes:
+    if data.dtype.kind != "f":
+        fmt = "%r"
+    elif precision is not None:
+        fmt = f"%.{precision}g"
+    elif data.dtype.itemsize < 8:
+        # %r would print the digits of the conversion to a double; NumPy
+        # prints the shortest digits that read back as the same value
+        data = data.astype(str)
+        fmt = "%s"
+    else:
+        fmt = "%r"
+
+    if data.ndim == 1:
+        row = fmt
+    else:
+        row = "(" + " ".join([fmt] * data.shape[1]) + ")"
+
+    template = " ".join([row] * _CHUNK_SIZE)
+    chunks = []
+    for i in range(0, len(data), _CHUNK_SIZE):
+        chunk = data[i : i + _CHUNK_SIZE]
+        if len(chunk) < _CHUNK_SIZE:
+            template = " ".join([row] * len(chunk))
+        chunks.append(template % tuple(chunk.ravel().tolist()))
+
+    return " ".join(chunks).encode("latin-1")
+
+
+def _dumpb_field_array(
+    data: "np.ndarray[Any, Any]",
+    *,
+    kind: Kind,
+    precision: Optional[int] = None,
+    arch: Optional[str] = None,
+) -> bytes:
+    tensor_kind = _TENSOR_KINDS[1 if data.ndim == 1 else data.shape[1]]
+
+    if kind == Kind.BINARY_FIELD:
+        _, scalar = arch_dtypes(arch)
+        contents = np.ascontiguousarray(data, dtype=scalar).tobytes()
+    else:
+        contents = _dumpb_ascii_values(data, precision=precision)
+
+    return (
+        b"nonuniform List<"
+        + tensor_kind
+        + b"> "
+        + dumpb(len(data))
+        + b"("
+        + contents
+        + b")"
+    )
+
+
 def dumpb(
     data: FoamDict._SetData,
     *,
     kind: Kind = Kind.DEFAULT,
+    precision: Optional[int] = None,
+    arch: Optional[str] = None,
 ) -> bytes:
-    if numpy and isinstance(data, np.ndarray):
-        return dumpb(data.tolist(), kind=kind)
+    if isinstance(data, np.ndarray):
+        if kind in (Kind.FIELD, Kind.BINARY_FIELD) and _is_nonuniform_field(data):
+            return _dumpb_field_array(data, kind=kind, precision=precision, arch=arch)
+        if (
+            kind in (Kind.DEFAULT, Kind.SINGLE_ENTRY)
+            and data.dtype.kind in "iuf"
+            and data.ndim in (1, 2)
+            and data.size > 0
+        ):
+            # Lists outside of fields are always written in ASCII, so arch
+            # does not apply to them
+            return b"(" + _dumpb_ascii_values(data, precision=precision) + b")"
+        return dumpb(data.tolist(), kind=kind, precision=precision, arch=arch)
 
     elif isinstance(data, Mapping):
         entries = []
         for k, v in data.items():
-            b = dumpb(v, kind=kind)
+            b = dumpb(v, kind=kind, precision=precision, arch=arch)
             if not k:
                 entries.append(b)
             elif isinstance(v, Mapping):
@@ -65,6 +144,16 @@ def dumpb(
         return b"uniform " + dumpb(data, kind=Kind.SINGLE_ENTRY)
 
     elif (kind == Kind.FIELD or kind == Kind.BINARY_FIELD) and is_sequence(data):
+        try:
+            arr = np.asarray(data)
+        except ValueError:
+            pass
+        else:
+            if _is_nonuniform_field(arr):
+                return _dumpb_field_array(
+                    arr, kind=kind, precision=precision, arch=arch
+                )
+
         if isinstance(data[0], (int, float)):
             tensor_kind = b"scalar"
         elif len(data[0]) == 3:
@@ -77,14 +166,14 @@ def dumpb(
             return dumpb(data)
 
         if kind == Kind.BINARY_FIELD:
+            scalar = arch_dtypes(arch)[1]
             if tensor_kind == b"scalar":
-                contents = b"(" + array.array("d", data).tobytes() + b")"
+                values = array.array(scalar.char, data)
             else:
-                contents = (
-                    b"("
-                    + array.array("d", itertools.chain.from_iterable(data)).tobytes()
-                    + b")"
-                )
+                values = array.array(scalar.char, itertools.chain.from_iterable(data))
+            if not scalar.isnative:
+                values.byteswap()
+            contents = b"(" + values.tobytes() + b")"
         else:
             contents = dumpb(data, kind=Kind.SINGLE_ENTRY)
 
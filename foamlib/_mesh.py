@@ -0,0 +1,410 @@
+import itertools
+import re
+import sys
+import warnings
+from pathlib import Path
+from typing import Any, Dict, Tuple, Union
+
+if sys.version_info >= (3, 9):
+    from collections.abc import Mapping
+else:
+    from typing import Mapping
+
+import numpy as np
+
+from ._files import FoamDict
+from ._files._fast_parsing import arch_dtypes
+from ._files._io import FoamFileIO
+from ._util import is_sequence
+
+_FACE_SIZE = re.compile(rb"(\d+)\s*\(")
+_PARENS_TO_SPACES = bytes.maketrans(b"()", b"  ")
+
+# Same thresholds as OpenFOAM's primitiveMesh (double precision)
+_VSMALL = 1e-300
+_ROOT_VSMALL = 1e-150
+
+# Faces processed at once when computing face geometry, to bound the size of
+# temporary per-face-point arrays
+_FACE_CHUNK = 1 << 20
+
+
+def _fromstring(data: bytes, dtype: "np.dtype[Any]") -> "np.ndarray[Any, Any]":
+    with warnings.catch_warnings():
+        warnings.simplefilter("ignore", DeprecationWarning)
+        return np.fromstring(data, dtype=dtype, sep=" ")  # type: ignore [call-overload, no-any-return]
+
+
+def _list_body(data: bytes) -> Tuple[int, bytes]:
+    # Count (-1 if absent) and contents of an ASCII list N(...)
+    start = data.index(b"(")
+    end = data.rindex(b")")
+    count = data[:start].strip()
+    return int(count) if count else -1, data[start + 1 : end]
+
+
+def _sum_by(
+    index: "np.ndarray[Any, Any]", values: "np.ndarray[Any, Any]", n: int
+) -> "np.ndarray[Any, Any]":
+    # Sum of the rows of values (shape (len(index), 3)) with the same index
+    return np.stack(
+        [np.bincount(index, weights=values[:, i], minlength=n) for i in range(3)],
+        axis=1,
+    )
+
+
+def _face_geometry(
+    points: "np.ndarray[Any, Any]",
+    offsets: "np.ndarray[Any, Any]",
+    face_points: "np.ndarray[Any, Any]",
+) -> Tuple["np.ndarray[Any, Any]", "np.ndarray[Any, Any]"]:
+    # Face centres and area vectors, as in primitiveMesh::makeFaceCentresAndAreas:
+    # each face is split into triangles around the average of its points, and
+    # its centre is the area-weighted average of the triangle centres
+    n_faces = len(offsets) - 1
+    centres = np.empty((n_faces, 3))
+    areas = np.empty((n_faces, 3))
+
+    for start in range(0, n_faces, _FACE_CHUNK):
+        stop = min(start + _FACE_CHUNK, n_faces)
+        chunk = offsets[start : stop + 1] - offsets[start]
+        n = stop - start
+        sizes = np.diff(chunk)
+        face = np.repeat(np.arange(n), sizes)
+
+        # Position of the next point of the same face, wrapping around
+        following = np.arange(1, int(chunk[-1]) + 1)
+        following[chunk[1:] - 1] = chunk[:-1]
+
+        labels = face_points[offsets[start] : offsets[stop]]
+        p = points[labels]
+        q = points[labels[following]]
+        estimate = _sum_by(face, p, n) / sizes[:, None]
+        e = estimate[face]
+
+        normals = np.cross(q - p, e - p)
+        mags = np.sqrt(np.sum(normals * normals, axis=1))
+        sum_n = _sum_by(face, normals, n)
+        sum_a = np.bincount(face, weights=mags, minlength=n)
+        sum_ac = _sum_by(face, mags[:, None] * (p + q + e), n)
+
+        degenerate = sum_a < _ROOT_VSMALL
+        centres[start:stop] = np.where(
+            degenerate[:, None],
+            estimate,
+            sum_ac / (3 * np.where(degenerate, 1, sum_a))[:, None],
+        )
+        areas[start:stop] = np.where(degenerate[:, None], sum_n, 0.5 * sum_n)
+
+    return centres, areas
+
+
+def _cell_geometry(
+    face_centres: "np.ndarray[Any, Any]",
+    face_areas: "np.ndarray[Any, Any]",
+    owner: "np.ndarray[Any, Any]",
+    neighbour: "np.ndarray[Any, Any]",
+    n_cells: int,
+) -> Tuple["np.ndarray[Any, Any]", "np.ndarray[Any, Any]"]:
+    # Cell centres and volumes, as in primitiveMesh::makeCellCentresAndVols:
+    # each cell is split into pyramids with the faces as bases and the average
+    # of the face centres as apex
+    n_internal = len(neighbour)
+    cells = np.concatenate((owner, neighbour))
+    centres = np.concatenate((face_centres, face_centres[:n_internal]))
+
+    n_cell_faces = np.bincount(cells, minlength=n_cells)
+    estimate = _sum_by(cells, centres, n_cells)
+    estimate /= np.maximum(n_cell_faces, 1)[:, None]
+
+    # Three times the volume of each pyramid, with the face area vectors
+    # pointing out of the owner and into the neighbour
+    heights = centres - estimate[cells]
+    heights[len(owner) :] *= -1
+    pyramids = np.maximum(
+        np.sum(np.concatenate((face_areas, face_areas[:n_internal])) * heights, axis=1),
+        _VSMALL,
+    )
+
+    volumes = np.bincount(cells, weights=pyramids, minlength=n_cells)
+    weighted = _sum_by(
+        cells, pyramids[:, None] * (0.75 * centres + 0.25 * estimate[cells]), n_cells
+    )
+
+    valid = np.abs(volumes) > _VSMALL
+    centres = np.where(
+        valid[:, None], weighted / np.where(valid, volumes, 1)[:, None], estimate
+    )
+    return centres, volumes / 3
+
+
+class _MeshFile(FoamFileIO):
+    def _data(self) -> Tuple[Any, "np.dtype[Any]", bool]:
+        # Standalone data of the file; for ASCII files, the raw bytes
+        contents, parsed = self._read()
+
+        arch = parsed.get(("FoamFile", "arch"))
+        label, _ = arch_dtypes(arch if isinstance(arch, str) else None)
+
+        if parsed.get(("FoamFile", "format")) != "binary":
+            start, end = parsed.entry_location(("",))
+            return bytes(contents[start:end]), label, True
+
+        return parsed[""], label, False
+
+    def labels(self) -> "np.ndarray[Any, Any]":
+        data, label, raw = self._data()
+
+        if raw:
+            try:
+                count, body = _list_body(data)
+                ret = _fromstring(body, label)
+            except ValueError:
+                pass
+            else:
+                if count in (-1, len(ret)):
+                    ret.flags.writeable = False
+                    return ret
+            data = self._parsed_data()
+
+        ret = np.asarray(data, dtype=label)
+        ret.flags.writeable = False
+        return ret
+
+    def points(self) -> "np.ndarray[Any, Any]":
+        data, _, raw = self._data()
+
+        if raw:
+            try:
+                count, body = _list_body(data)
+                ret = _fromstring(body.translate(_PARENS_TO_SPACES), np.dtype(float))
+            except ValueError:
+                pass
+            else:
+                if len(ret) % 3 == 0 and count in (-1, len(ret) // 3):
+                    ret = ret.reshape(-1, 3)
+                    ret.flags.writeable = False
+                    return ret
+            data = self._parsed_data()
+
+        ret = np.asarray(data, dtype=float).reshape(-1, 3)
+        ret.flags.writeable = False
+        return ret
+
+    def faces(self) -> Tuple["np.ndarray[Any, Any]", "np.ndarray[Any, Any]"]:
+        data, label, raw = self._data()
+
+        if raw:
+            try:
+                ret = self._ascii_faces(data, label)
+            except ValueError:
+                data = self._parsed_data()
+            else:
+                return ret
+
+        if isinstance(data, tuple) and len(data) == 2:
+            # faceCompactList
+            offsets, points = (np.asarray(d, dtype=label) for d in data)
+        else:
+            sizes = np.fromiter(map(len, data), dtype=label, count=len(data))
+            offsets = np.concatenate(([0], np.cumsum(sizes))).astype(label)
+            points = np.fromiter(
+                itertools.chain.from_iterable(data),
+                dtype=label,
+                count=int(offsets[-1]),
+            )
+
+        offsets.flags.writeable = False
+        points.flags.writeable = False
+        return offsets, points
+
+    @staticmethod
+    def _ascii_faces(
+        data: bytes, label: "np.dtype[Any]"
+    ) -> Tuple["np.ndarray[Any, Any]", "np.ndarray[Any, Any]"]:
+        # Read all numbers at once, then remove the size that precedes the
+        # points of each face
+        count, body = _list_body(data)
+
+        sizes = _fromstring(b" ".join(_FACE_SIZE.findall(body)), label)
+        values = _fromstring(body.translate(_PARENS_TO_SPACES), label)
+        n = len(sizes)
+        if count not in (-1, n) or len(values) != n + int(sizes.sum()):
+            raise ValueError("invalid face list")
+
+        offsets = np.concatenate(([0], np.cumsum(sizes))).astype(label)
+        positions = offsets[:-1] + np.arange(n)
+        if not np.array_equal(values[positions], sizes):
+            raise ValueError("invalid face list")
+
+        keep = np.ones(len(values), dtype=bool)
+        keep[positions] = False
+        points = values[keep]
+
+        offsets.flags.writeable = False
+        points.flags.writeable = False
+        return offsets, points
+
+    def _parsed_data(self) -> FoamDict.Data:
+        _, parsed = self._read()
+        data = parsed[""]
+        if data is ...:
+            raise ValueError(f"expected a list in {self.path}, found a dictionary")
+        return data
+
+    def boundary(self) -> Dict[str, FoamDict._Dict]:
+        _, parsed = self._read()
+        data = parsed[""]
+
+        ret: Dict[str, FoamDict._Dict] = {}
+        if is_sequence(data):
+            for entry in data:
+                if isinstance(entry, Mapping):
+                    ret.update(entry)  # type: ignore [arg-type]
+        return ret
+
+
+class FoamMesh:
+    """
+    An OpenFOAM polyMesh, with its points, faces and connectivity as NumPy arrays.
+
+    Each array is read the first time it is accessed, and then kept. Arrays are read-only. Binary files are memory-mapped, so that their values are only loaded from disk as they are used; ASCII and compressed files are read into memory.
+
+    Faces are stored in compressed sparse row (CSR) form: the points of face `i` are `face_points[face_offsets[i]:face_offsets[i + 1]]`.
+
+    Face and cell centres, face areas and cell volumes are computed from the mesh on first access, using the same decomposition into triangles and pyramids as OpenFOAM.
+
+    :param path: The path to the polyMesh directory, e.g. `constant/polyMesh` in a case.
+    """
+
+    def __init__(self, path: Union[str, Path]) -> None:
+        self.path = Path(path).absolute()
+        self.__cache: Dict[str, Any] = {}
+
+    def _file(self, name: str) -> _MeshFile:
+        path = self.path / name
+        if not path.is_file() and path.with_name(f"{name}.gz").is_file():
+            path = path.with_name(f"{name}.gz")
+        return _MeshFile(path, memory_map=True)
+
+    def _get(self, name: str) -> Any:
+        try:
+            return self.__cache[name]
+        except KeyError:
+            pass
+
+        if name == "faces":
+            ret: Any = self._file("faces").faces()
+        elif name == "points":
+            ret = self._file("points").points()
+        elif name == "boundary":
+            ret = self._file("boundary").boundary()
+        elif name == "face_geometry":
+            ret = _face_geometry(self.points, self.face_offsets, self.face_points)
+        elif name == "cell_geometry":
+            ret = _cell_geometry(
+                self.face_centres,
+                self.face_areas,
+                self.owner,
+                self.neighbour,
+                self.n_cells,
+            )
+        else:
+            ret = self._file(name).labels()
+
+        if name.endswith("_geometry"):
+            for array in ret:
+                array.flags.writeable = False
+
+        self.__cache[name] = ret
+        return ret
+
+    @property
+    def points(self) -> "np.ndarray[Any, Any]":
+        """Coordinates of the points, as an array of shape `(n_points, 3)`."""
+        return self._get("points")  # type: ignore [no-any-return]
+
+    @property
+    def face_offsets(self) -> "np.ndarray[Any, Any]":
+        """Start of the points of each face in `face_points`, followed by the total number of face points (an array of size `n_faces + 1`)."""
+        return self._get("faces")[0]  # type: ignore [no-any-return]
+
+    @property
+    def face_points(self) -> "np.ndarray[Any, Any]":
+        """Point labels of all faces, concatenated in order."""
+        return self._get("faces")[1]  # type: ignore [no-any-return]
+
+    @property
+    def owner(self) -> "np.ndarray[Any, Any]":
+        """Owner cell of each face."""
+        return self._get("owner")  # type: ignore [no-any-return]
+
+    @property
+    def neighbour(self) -> "np.ndarray[Any, Any]":
+        """Neighbour cell of each internal face."""
+        return self._get("neighbour")  # type: ignore [no-any-return]
+
+    @property
+    def boundary(self) -> Dict[str, FoamDict._Dict]:
+        """The boundary patches, by name, with their `type`, `nFaces` and `startFace` entries."""
+        return self._get("boundary")  # type: ignore [no-any-return]
+
+    @property
+    def cell_proc_addressing(self) -> "np.ndarray[Any, Any]":
+        """For the mesh of a processor in a decomposed case, the label of each cell in the complete mesh (from the `cellProcAddressing` file written by `decomposePar`)."""
+        return self._get("cellProcAddressing")  # type: ignore [no-any-return]
+
+    @property
+    def face_centres(self) -> "np.ndarray[Any, Any]":
+        """Centre of each face, as an array of shape `(n_faces, 3)`."""
+        return self._get("face_geometry")[0]  # type: ignore [no-any-return]
+
+    @property
+    def face_areas(self) -> "np.ndarray[Any, Any]":
+        """Area vector of each face (normal to the face, pointing out of its owner cell, with the face area as magnitude), as an array of shape `(n_faces, 3)`."""
+        return self._get("face_geometry")[1]  # type: ignore [no-any-return]
+
+    @property
+    def cell_centres(self) -> "np.ndarray[Any, Any]":
+        """Centre of each cell, as an array of shape `(n_cells, 3)`. Same as computed by OpenFOAM (e.g. `postProcess -func writeCellCentres`)."""
+        return self._get("cell_geometry")[0]  # type: ignore [no-any-return]
+
+    @property
+    def cell_volumes(self) -> "np.ndarray[Any, Any]":
+        """Volume of each cell."""
+        return self._get("cell_geometry")[1]  # type: ignore [no-any-return]
+
+    @property
+    def n_points(self) -> int:
+        """Number of points."""
+        return len(self.points)
+
+    @property
+    def n_faces(self) -> int:
+        """Number of faces."""
+        return len(self.owner)
+
+    @property
+    def n_internal_faces(self) -> int:
+        """Number of internal faces."""
+        return len(self.neighbour)
+
+    @property
+    def n_cells(self) -> int:
+        """Number of cells."""
+        if "n_cells" not in self.__cache:
+            n = max(
+                int(self.owner.max()) if len(self.owner) else -1,
+                int(self.neighbour.max()) if len(self.neighbour) else -1,
+            )
+            self.__cache["n_cells"] = n + 1
+        return self.__cache["n_cells"]  # type: ignore [no-any-return]
+
+    def __fspath__(self) -> str:
+        return str(self.path)
+
+    def __repr__(self) -> str:
+        return f"{type(self).__qualname__}('{self.path}')"
+
+    def __str__(self) -> str:
+        return str(self.path)
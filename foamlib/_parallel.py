@@ -0,0 +1,33 @@
+import os
+from concurrent.futures import Executor, ProcessPoolExecutor, ThreadPoolExecutor
+from typing import Callable, Iterable, List, Optional, TypeVar
+
+T = TypeVar("T")
+R = TypeVar("R")
+
+
+def parallel_map(
+    fn: Callable[[T], R],
+    items: Iterable[T],
+    *,
+    max_workers: Optional[int] = None,
+    processes: bool = True,
+) -> List[R]:
+    # Like list(map(fn, items)), with a pool of worker processes (for
+    # CPU-bound work, as fn and results must then be picklable) or threads
+    items = list(items)
+    workers = min(max_workers or os.cpu_count() or 1, len(items))
+    if workers <= 1:
+        return [fn(item) for item in items]
+
+    executor: Executor
+    if processes:
+        executor = ProcessPoolExecutor(workers)
+        # Send items in a few batches per worker to reduce overhead
+        chunksize = max(1, len(items) // (4 * workers))
+    else:
+        executor = ThreadPoolExecutor(workers)
+        chunksize = 1
+
+    with executor:
+        return list(executor.map(fn, items, chunksize=chunksize))
@@ -2,6 +2,7 @@ import asyncio
 import os
 import subprocess
 import sys
+import time
 from pathlib import Path
 from typing import Any, Optional, Union
 from warnings import warn
@@ -17,6 +18,17 @@ else:
     from typing_extensions import TypeGuard
 
 
+# Timestamps are only as fine as the filesystem's granularity (up to 2 s on
+# FAT), so a change made within one tick of a stat can leave the stat
+# unchanged. As git does for its index, a stat is not trusted to detect
+# later changes if it was taken less than this after the last modification
+RACY_NS = 2 * 10**9
+
+
+def is_racy(mtime_ns: int) -> bool:
+    return time.time_ns() - mtime_ns < RACY_NS
+
+
 def is_sequence(
     value: Any,
 ) -> TypeGuard[Sequence[Any]]:
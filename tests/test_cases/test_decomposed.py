@@ -0,0 +1,137 @@
+from pathlib import Path
+
+import numpy as np
+import pytest
+from foamlib import FoamCase, FoamFieldFile
+
+
+def write_field(path: Path, values: "np.ndarray") -> None:
+    path.parent.mkdir(parents=True, exist_ok=True)
+    path.touch()
+    f = FoamFieldFile(path)
+    f["FoamFile"] = {"class": "volScalarField"}
+    f["dimensions"] = FoamFieldFile.DimensionSet(length=2, time=-2)
+    f.internal_field = values
+    f["boundaryField"] = {"walls": {"type": "zeroGradient"}}
+
+
+def write_addressing(path: Path, labels: "np.ndarray") -> None:
+    path.parent.mkdir(parents=True, exist_ok=True)
+    path.write_text(
+        "FoamFile\n{\n    version 2.0;\n    format ascii;\n    class labelList;\n}\n"
+        f"{len(labels)}\n(\n" + "\n".join(map(str, labels.tolist())) + "\n)\n"
+    )
+
+
+@pytest.fixture
+def decomposed(tmp_path: Path) -> FoamCase:
+    # 12 processors with 4 cells each; cell j of processor i is cell 12 * j + i
+    for i in range(12):
+        write_addressing(
+            tmp_path / f"processor{i}" / "constant" / "polyMesh" / "cellProcAddressing",
+            np.arange(4) * 12 + i,
+        )
+        for time in ("0", "0.5"):
+            write_field(
+                tmp_path / f"processor{i}" / time / "p",
+                np.arange(i, i + 4, dtype=float) * float(time),
+            )
+    (tmp_path / "processors12").mkdir()
+    return FoamCase(tmp_path)
+
+
+def test_processors(decomposed: FoamCase) -> None:
+    processors = decomposed.processors
+    assert [p.name for p in processors] == [f"processor{i}" for i in range(12)]
+    assert processors[0][-1].name == "0.5"
+
+
+@pytest.mark.parametrize("processes", [True, False])
+def test_processor_fields(decomposed: FoamCase, processes: bool) -> None:
+    fields = decomposed.processor_fields("p", max_workers=4, processes=processes)
+    assert len(fields) == 12
+    for i, field in enumerate(fields):
+        assert isinstance(field, np.ndarray)
+        assert field.tolist() == [(i + j) * 0.5 for j in range(4)]
+
+    fields = decomposed.processor_fields("p", 0.0, processes=processes)
+    assert [f.tolist() for f in fields] == [[0] * 4] * 12  # type: ignore [union-attr]
+
+    with pytest.raises(KeyError):
+        decomposed.processor_fields("U", "0", processes=processes)
+
+
+@pytest.mark.parametrize("processes", [True, False])
+def test_reconstruct_field(decomposed: FoamCase, processes: bool) -> None:
+    p = decomposed.reconstruct_field("p", processes=processes)
+    assert isinstance(p, np.ndarray)
+    assert p.shape == (48,)
+    assert p.tolist() == [(c % 12 + c // 12) * 0.5 for c in range(48)]
+
+    for i in range(12):
+        write_field(
+            decomposed.path / f"processor{i}" / "1" / "p",
+            np.full(4, float(i)) if i % 2 else 2.0,  # type: ignore [arg-type]
+        )
+    p = decomposed.reconstruct_field("p", "1", processes=processes)
+    assert p.tolist() == [float(c % 12) if c % 2 else 2.0 for c in range(48)]
+
+
+def test_reconstruct_missing_cells(decomposed: FoamCase) -> None:
+    (decomposed.path / "processor11").rename(decomposed.path / "other")
+    with pytest.raises(ValueError):
+        decomposed.reconstruct_field("p", processes=False)
+
+
+@pytest.fixture
+def contiguous(tmp_path: Path) -> FoamCase:
+    # 2 processors with 2 cells each; processor1 holds the last cells
+    for i in range(2):
+        write_addressing(
+            tmp_path / f"processor{i}" / "constant" / "polyMesh" / "cellProcAddressing",
+            np.arange(2) + 2 * i,
+        )
+        write_field(tmp_path / f"processor{i}" / "0" / "p", np.arange(2.0) + 2 * i)
+    return FoamCase(tmp_path)
+
+
+@pytest.mark.parametrize("check", ["mesh", "decomposeParDict"])
+def test_reconstruct_missing_last_processor(contiguous: FoamCase, check: str) -> None:
+    if check == "mesh":
+        mesh = contiguous.path / "constant" / "polyMesh"
+        write_addressing(mesh / "owner", np.array([0, 1, 2]))
+        write_addressing(mesh / "neighbour", np.array([1, 2, 3]))
+    else:
+        (contiguous.path / "system").mkdir()
+        (contiguous.path / "system" / "decomposeParDict").write_text(
+            "numberOfSubdomains 2;\n"
+        )
+    assert contiguous.reconstruct_field("p", processes=False).tolist() == [0, 1, 2, 3]
+
+    (contiguous.path / "processor1").rename(contiguous.path / "other")
+    with pytest.raises(ValueError):
+        contiguous.reconstruct_field("p", processes=False)
+    with pytest.raises(ValueError):
+        contiguous.decompose_field("p", np.zeros(2), processes=False)
+    with pytest.raises(ValueError):
+        contiguous.decompose_field("p", np.zeros(4), processes=False)
+    field = contiguous.processor_fields("p", processes=False)[0]
+    assert isinstance(field, np.ndarray)
+    assert field.tolist() == [0, 1]
+
+
+@pytest.mark.parametrize("processes", [True, False])
+def test_decompose_field(decomposed: FoamCase, processes: bool) -> None:
+    decomposed.decompose_field("p", np.arange(48, dtype=float), processes=processes)
+
+    fields = decomposed.processor_fields("p", "0", processes=processes)
+    for i, field in enumerate(fields):
+        assert isinstance(field, np.ndarray)
+        assert field.tolist() == [12 * j + i for j in range(4)]
+    assert decomposed.reconstruct_field("p", "0").tolist() == list(range(48))
+
+    boundary = decomposed.processors[3]["0"]["p"].boundary_field
+    assert boundary["walls"].type == "zeroGradient"
+
+    with pytest.raises(ValueError):
+        decomposed.decompose_field("p", np.zeros(47), processes=processes)
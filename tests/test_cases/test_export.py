@@ -0,0 +1,149 @@
+import sys
+from pathlib import Path
+from types import SimpleNamespace
+from typing import Any, Dict
+
+import numpy as np
+import pytest
+from foamlib import FoamCase, FoamFieldFile, _export, _mesh
+
+from ..test_mesh.test_mesh import write_mesh
+
+
+@pytest.fixture
+def case(tmp_path: Path) -> FoamCase:
+    # 4 cells in a row, with p at all times and U only after the first
+    write_mesh(tmp_path / "case" / "constant" / "polyMesh", 4)
+    for t in ("0", "0.5", "1"):
+        for name, cls in (("p", "volScalarField"), ("U", "volVectorField")):
+            if name == "U" and t == "0":
+                continue
+            (tmp_path / "case" / t).mkdir(exist_ok=True)
+            path = tmp_path / "case" / t / name
+            path.touch()
+            f = FoamFieldFile(path)
+            f["FoamFile"] = {"class": cls}
+            f["dimensions"] = FoamFieldFile.DimensionSet(length=1, time=-1)
+            if name == "p":
+                f.internal_field = np.array([1.0, 2.0, 4.0, 8.0]) * float(t)
+            else:
+                f.internal_field = np.full((4, 3), float(t))
+            f["boundaryField"] = {}
+
+    return FoamCase(tmp_path / "case")
+
+
+def test_export_npy(case: FoamCase, monkeypatch: pytest.MonkeyPatch) -> None:
+    calls = []
+    face_geometry = _mesh._face_geometry
+
+    def count(*args: Any) -> Any:
+        calls.append(args)
+        return face_geometry(*args)
+
+    monkeypatch.setattr(_mesh, "_face_geometry", count)
+
+    dest = case.path.parent / "export"
+    case.export(dest, max_workers=2)
+    assert len(calls) == 1
+
+    assert np.load(dest / "fields" / "p" / "times.npy").tolist() == [0, 0.5, 1]
+    p = np.load(dest / "fields" / "p" / "values.npy", mmap_mode="r")
+    assert p.shape == (3, 4)
+    assert p.tolist() == [[0, 0, 0, 0], [0.5, 1, 2, 4], [1, 2, 4, 8]]
+
+    assert np.load(dest / "fields" / "U" / "times.npy").tolist() == [0.5, 1]
+    U = np.load(dest / "fields" / "U" / "values.npy")
+    assert U.shape == (2, 4, 3)
+    assert U.tolist() == [[[0.5] * 3] * 4, [[1.0] * 3] * 4]
+
+    assert np.load(dest / "mesh" / "points.npy").shape == (20, 3)
+    assert np.load(dest / "mesh" / "owner.npy").tolist() == case.mesh.owner.tolist()
+    assert np.allclose(np.load(dest / "mesh" / "cell_volumes.npy"), [1, 1, 1, 1])
+
+
+def test_export_selection(case: FoamCase) -> None:
+    dest = case.path.parent / "export"
+    case.export(dest, ["p"], times=case[1:], mesh=False, processes=False)
+
+    assert sorted(p.name for p in dest.iterdir()) == ["fields"]
+    assert sorted(p.name for p in (dest / "fields").iterdir()) == ["p"]
+    assert np.load(dest / "fields" / "p" / "times.npy").tolist() == [0.5, 1]
+
+    with pytest.raises(ValueError):
+        case.export(dest, format="csv")
+
+    with pytest.raises(KeyError):
+        case.export(case.path.parent / "missing", ["p", "T"])
+    assert not (case.path.parent / "missing").exists()
+
+
+@pytest.mark.parametrize("format", ["zarr", "hdf5"])
+def test_export_formats(case: FoamCase, format: str) -> None:
+    pytest.importorskip("zarr" if format == "zarr" else "h5py")
+
+    dest = case.path.parent / "export"
+    case.export(dest, format=format, processes=False)
+
+    if format == "zarr":
+        import zarr  # type: ignore [import-not-found]
+
+        root = zarr.open_group(str(dest), mode="r")
+        p = root["fields"]["p"]["values"][...]
+        points = root["mesh"]["points"][...]
+    else:
+        import h5py  # type: ignore [import-not-found]
+
+        with h5py.File(dest, "r") as f:
+            p = f["fields/p/values"][...]
+            points = f["mesh/points"][...]
+
+    assert p.tolist() == [[0, 0, 0, 0], [0.5, 1, 2, 4], [1, 2, 4, 8]]
+    assert points.shape == (20, 3)
+
+
+class _FakeGroup:
+    # Records the chunks of the arrays created through the zarr and h5py APIs
+    def __init__(self, chunks: Dict[str, Any], prefix: str = "") -> None:
+        self.chunks = chunks
+        self.prefix = prefix
+
+    def require_group(self, name: str) -> "_FakeGroup":
+        return _FakeGroup(self.chunks, f"{self.prefix}{name}/")
+
+    def zeros(self, *, name: str, shape: Any, chunks: Any, dtype: Any) -> Any:
+        return self.create_dataset(
+            f"{self.prefix}{name}", shape=shape, dtype=dtype, chunks=chunks
+        )
+
+    def create_dataset(self, name: str, *, shape: Any, dtype: Any, chunks: Any) -> Any:
+        self.chunks[name] = chunks
+        return np.zeros(shape, dtype=dtype)
+
+    def close(self) -> None:
+        pass
+
+
+@pytest.mark.parametrize("format", ["zarr", "hdf5"])
+def test_export_chunks(
+    case: FoamCase, format: str, monkeypatch: pytest.MonkeyPatch
+) -> None:
+    chunks: Dict[str, Any] = {}
+    group = _FakeGroup(chunks)
+    monkeypatch.setitem(
+        sys.modules, "zarr", SimpleNamespace(open_group=lambda *args, **kwargs: group)
+    )
+    monkeypatch.setitem(
+        sys.modules, "h5py", SimpleNamespace(File=lambda *args, **kwargs: group)
+    )
+    monkeypatch.setattr(_export, "_CHUNK_ROWS", 8)
+
+    case.export(case.path.parent / "export", format=format, processes=False)
+
+    assert chunks["fields/p/values"] == (1, 4)
+    assert chunks["fields/U/values"] == (1, 4, 3)
+    assert chunks["fields/p/times"] == (3,)
+    assert chunks["mesh/points"] == (8, 3)
+    assert chunks["mesh/cell_centres"] == (4, 3)
+    assert chunks["mesh/face_points"] == (8,)
+    assert chunks["mesh/owner"] == (8,)
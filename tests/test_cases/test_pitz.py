@@ -1,7 +1,7 @@
 import os
 from pathlib import Path
-from typing import Sequence
 
+import numpy as np
 import pytest
 from foamlib import FoamCase
 
@@ -23,7 +23,7 @@ def test_run(pitz: FoamCase) -> None:
     pitz.run()
     assert len(pitz) > 0
     internal = pitz[-1]["U"].internal_field
-    assert isinstance(internal, Sequence)
+    assert isinstance(internal, np.ndarray)
     assert len(internal) == 12225
 
 
@@ -31,3 +31,17 @@ def test_double_clean(pitz: FoamCase) -> None:
     pitz.clean()
     pitz.clean(check=True)
     pitz.run()
+
+
+def test_mesh(pitz: FoamCase) -> None:
+    pitz.run()
+    mesh = pitz.mesh
+    assert mesh.n_cells == 12225
+    assert mesh.points.shape == (mesh.n_points, 3)
+    assert len(mesh.face_offsets) == mesh.n_faces + 1
+    n_boundary_faces = 0
+    for patch in mesh.boundary.values():
+        n = patch["nFaces"]
+        assert isinstance(n, int)
+        n_boundary_faces += n
+    assert n_boundary_faces == mesh.n_faces - mesh.n_internal_faces
@@ -0,0 +1,150 @@
+import os
+import time
+from pathlib import Path
+
+import numpy as np
+import pytest
+from foamlib import FoamCase, FoamFieldFile
+
+
+def test_times(tmp_path: Path) -> None:
+    for name in ("0", "0.1", "0.3", "1e-05", "10", "2"):
+        (tmp_path / name).mkdir()
+    (tmp_path / "constant").mkdir()
+    (tmp_path / "5").touch()
+
+    case = FoamCase(tmp_path)
+    assert [t.name for t in case] == ["0", "1e-05", "0.1", "0.3", "2", "10"]
+    assert len(case) == 6
+    assert case[-1].name == "10"
+    assert [t.name for t in case[1:3]] == ["1e-05", "0.1"]
+
+    assert case[2.0].name == "2"
+    assert case[0.1 + 0.2].name == "0.3"
+    assert case[1e-5].name == "1e-05"
+    with pytest.raises(IndexError):
+        case[0.2]
+    with pytest.raises(IndexError):
+        case[0.30001]
+
+    # Backdate the case directory so that the index is cached; any change
+    # then gives it a new mtime, whatever the timestamp resolution
+    os.utime(tmp_path, (0, 0))
+    assert len(case) == 6
+    (tmp_path / "20").mkdir()
+    (tmp_path / "0.1").rmdir()
+    assert len(case) == 6
+    assert case[-1].name == "20"
+    with pytest.raises(IndexError):
+        case[0.1]
+
+    # A change within the same timestamp tick leaves the mtime (and here
+    # the link count) unchanged, but an index built that recently is not
+    # reused
+    now = time.time_ns()
+    os.utime(tmp_path, ns=(now, now))
+    assert case[-1].name == "20"
+    (tmp_path / "20").rename(tmp_path / "30")
+    os.utime(tmp_path, ns=(now, now))
+    assert case[-1].name == "30"
+
+
+def test_times_incremental(tmp_path: Path) -> None:
+    for name in ("0", "1", "2"):
+        (tmp_path / name).mkdir()
+
+    case = FoamCase(tmp_path)
+    times = list(case)
+
+    # Directories already indexed are kept when others are added or removed,
+    # including right after a change
+    (tmp_path / "3").mkdir()
+    assert [t.name for t in case] == ["0", "1", "2", "3"]
+    assert all(t is u for t, u in zip(case, times))
+
+    (tmp_path / "0.5").mkdir()
+    (tmp_path / "1").rmdir()
+    assert [t.name for t in case] == ["0", "0.5", "2", "3"]
+    assert case[0] is times[0]
+    assert case[2] is times[2]
+    assert case[0.5].name == "0.5"
+
+
+def test_time_precision(tmp_path: Path) -> None:
+    (tmp_path / "system").mkdir()
+    (tmp_path / "system" / "controlDict").write_text("timePrecision 3;\n")
+    (tmp_path / "0.123").mkdir()
+
+    case = FoamCase(tmp_path)
+    assert case[0.1234].name == "0.123"
+    with pytest.raises(IndexError):
+        case[0.1236]
+
+
+@pytest.fixture
+def series(tmp_path: Path) -> FoamCase:
+    # 5 cells; boundary patches "inlet" (2 faces) and "outlet" (3 faces)
+    mesh = tmp_path / "constant" / "polyMesh"
+    mesh.mkdir(parents=True)
+    (mesh / "owner").write_text("5(0 1 2 3 4)\n")
+    (mesh / "neighbour").write_text("0()\n")
+    (mesh / "boundary").write_text(
+        "2(inlet { type patch; nFaces 2; startFace 0; }"
+        " outlet { type patch; nFaces 3; startFace 2; })\n"
+    )
+
+    for t in range(5):
+        (tmp_path / str(t)).mkdir()
+        for name, cls in (("p", "volScalarField"), ("U", "volVectorField")):
+            path = tmp_path / str(t) / name
+            path.touch()
+            f = FoamFieldFile(path)
+            f["FoamFile"] = {"class": cls}
+            f["dimensions"] = FoamFieldFile.DimensionSet(length=1, time=-1)
+            if name == "p":
+                f.internal_field = 0 if t == 0 else np.arange(5) + 10.0 * t
+                f["boundaryField"] = {
+                    "inlet": {"type": "fixedValue", "value": np.array([t, -t])},
+                    "outlet": {"type": "fixedValue", "value": t},
+                }
+            else:
+                f.internal_field = np.full((5, 3), float(t))
+                f["boundaryField"] = {"inlet": {"type": "zeroGradient"}}
+
+    return FoamCase(tmp_path)
+
+
+@pytest.mark.parametrize("processes", [True, False])
+def test_time_series(series: FoamCase, processes: bool) -> None:
+    p = series.time_series("p", [0, 3], processes=processes)
+    assert isinstance(p, np.ndarray)
+    assert p.shape == (5, 2)
+    assert p.tolist() == [[0, 0]] + [[10 * t, 10 * t + 3] for t in range(1, 5)]
+
+    p = series.time_series("p", processes=processes)
+    assert p.shape == (5, 5)
+    assert p[0].tolist() == [0] * 5
+
+    p = series.time_series("p", [], ["inlet", "outlet"], processes=processes)
+    assert p.tolist() == [[t, -t, t, t, t] for t in range(5)]
+
+    U = series.time_series("U", [4], times=series[1:3], processes=processes)
+    assert U.shape == (2, 1, 3)
+    assert U.tolist() == [[[1, 1, 1]], [[2, 2, 2]]]
+
+
+def test_time_series_chunks(series: FoamCase) -> None:
+    chunks = list(series.time_series("p", [1], chunk_size=2, processes=False))
+    assert [c.shape for c in chunks] == [(2, 1), (2, 1), (1, 1)]
+    assert [v for c in chunks for v in c[:, 0].tolist()] == [0, 11, 21, 31, 41]
+
+
+def test_time_series_errors(series: FoamCase) -> None:
+    with pytest.raises(ValueError, match="inlet"):
+        series.time_series("U", [0], ["inlet"], processes=False)
+
+    with pytest.raises(ValueError):
+        series.time_series("p", chunk_size=0)
+
+    p = series.time_series("p", [], processes=False)
+    assert p.shape == (5, 0)
@@ -1,3 +1,4 @@
+import numpy as np
 from foamlib import FoamFile
 from foamlib._files._serialization import Kind, dumpb
 
@@ -35,6 +36,50 @@ def test_serialize_data() -> None:
         dumpb([[1, 2, 3], [4, 5, 6]], kind=Kind.BINARY_FIELD)
         == b"nonuniform List<vector> 2(\x00\x00\x00\x00\x00\x00\xf0?\x00\x00\x00\x00\x00\x00\x00@\x00\x00\x00\x00\x00\x00\x08@\x00\x00\x00\x00\x00\x00\x10@\x00\x00\x00\x00\x00\x00\x14@\x00\x00\x00\x00\x00\x00\x18@)"
     )
+    assert dumpb(np.array([1, 2, 3]), kind=Kind.FIELD) == b"uniform (1 2 3)"
+    assert (
+        dumpb(np.array([1, 2, 3, 4, 5, 6, 7, 8, 9, 10]), kind=Kind.FIELD)
+        == b"nonuniform List<scalar> 10(1 2 3 4 5 6 7 8 9 10)"
+    )
+    assert (
+        dumpb(np.array([[1.0, 2.0, 3.0], [4.5, 5e-07, 6e20]]), kind=Kind.FIELD)
+        == b"nonuniform List<vector> 2((1.0 2.0 3.0) (4.5 5e-07 6e+20))"
+    )
+    assert (
+        dumpb(np.array([0.1, 1 / 3, 1e-5, 123456789.0]), kind=Kind.FIELD, precision=6)
+        == b"nonuniform List<scalar> 4(0.1 0.333333 1e-05 1.23457e+08)"
+    )
+    assert (
+        dumpb([[1 / 3, 2, 3], [4, 5, 6]], kind=Kind.FIELD, precision=3)
+        == b"nonuniform List<vector> 2((0.333 2 3) (4 5 6))"
+    )
+    assert (
+        dumpb(np.arange(1, 11), kind=Kind.FIELD, precision=1)
+        == b"nonuniform List<scalar> 10(1 2 3 4 5 6 7 8 9 10)"
+    )
+    assert (
+        dumpb(np.arange(1, 11), kind=Kind.BINARY_FIELD)
+        == b'nonuniform List<scalar> 10(\x00\x00\x00\x00\x00\x00\xf0?\x00\x00\x00\x00\x00\x00\x00@\x00\x00\x00\x00\x00\x00\x08@\x00\x00\x00\x00\x00\x00\x10@\x00\x00\x00\x00\x00\x00\x14@\x00\x00\x00\x00\x00\x00\x18@\x00\x00\x00\x00\x00\x00\x1c@\x00\x00\x00\x00\x00\x00 @\x00\x00\x00\x00\x00\x00"@\x00\x00\x00\x00\x00\x00$@)'
+    )
+    assert (
+        dumpb(np.array([[1, 2, 3], [4, 5, 6]], dtype=">f8"), kind=Kind.BINARY_FIELD)
+        == b"nonuniform List<vector> 2(\x00\x00\x00\x00\x00\x00\xf0?\x00\x00\x00\x00\x00\x00\x00@\x00\x00\x00\x00\x00\x00\x08@\x00\x00\x00\x00\x00\x00\x10@\x00\x00\x00\x00\x00\x00\x14@\x00\x00\x00\x00\x00\x00\x18@)"
+    )
+    assert (
+        dumpb(np.array([0.1, 1 / 3, 3, 4], dtype=np.float32), kind=Kind.FIELD)
+        == b"nonuniform List<scalar> 4(0.1 0.33333334 3.0 4.0)"
+    )
+    assert dumpb(np.array([0.1, 0.2], dtype=np.float32)) == b"(0.1 0.2)"
+    assert dumpb(np.array([[1, 2], [3, 4]])) == b"((1 2) (3 4))"
+    assert dumpb({"a": np.array([1.5, 2.0])}) == b"a (1.5 2.0);"
+    assert (
+        dumpb(
+            np.array([1, 2, 3, 4]),
+            kind=Kind.BINARY_FIELD,
+            arch='"LSB;label=32;scalar=32"',
+        )
+        == b"nonuniform List<scalar> 4(\x00\x00\x80?\x00\x00\x00@\x00\x00@@\x00\x00\x80@)"
+    )
     assert (
         dumpb(FoamFile.DimensionSet(mass=1, length=1, time=-2)) == b"[1 1 -2 0 0 0 0]"
     )
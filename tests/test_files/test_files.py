@@ -1,6 +1,11 @@
+import gzip
 import os
+import pickle
 import sys
+import time
+import tracemalloc
 from pathlib import Path
+from typing import Any, Tuple
 
 if sys.version_info >= (3, 9):
     from collections.abc import Sequence
@@ -10,6 +15,7 @@ else:
 import numpy as np
 import pytest
 from foamlib import FoamCase, FoamFieldFile, FoamFile
+from foamlib._files._parsing import Parsed
 
 
 def test_write_read(tmp_path: Path) -> None:
@@ -41,6 +47,7 @@ def test_write_read(tmp_path: Path) -> None:
     assert sd["key"] == "value"
     assert len(sd) == 1
     assert list(sd) == ["key"]
+    assert sd.as_dict() == {"key": "value"}
 
     d["subdict2"] = d["subdict"]
     sd2 = d["subdict2"]
@@ -75,6 +82,382 @@ def test_write_read(tmp_path: Path) -> None:
         lst[0] = 0
         assert lst == [0, 2, 3]
         assert d["subdict", "list"] == [1, 2, 3]
+        lst = sd.as_dict()["list"]
+        assert isinstance(lst, list)
+        lst[0] = 0
+        assert d["subdict", "list"] == [1, 2, 3]
+
+
+def test_trust_cache(tmp_path: Path) -> None:
+    path = tmp_path / "testDict"
+    path.write_text("key value;\n")
+
+    d = FoamFile(path)
+    trusting = FoamFile(path, trust_cache=True)
+    assert d["key"] == "value"
+    assert trusting["key"] == "value"
+
+    path.write_text("key other value;\n")
+    assert d["key"] == ("other", "value")
+    assert trusting["key"] == "value"
+
+    trusting["key"] = "new"
+    assert d["key"] == "new"
+    assert trusting["key"] == "new"
+
+
+def test_racy_stat(tmp_path: Path, monkeypatch: pytest.MonkeyPatch) -> None:
+    path = tmp_path / "testDict"
+    path.write_text("key a;\n")
+
+    # Simulate a filesystem with a coarse timestamp resolution, on which a
+    # same-size rewrite leaves the stat unchanged
+    stat = (time.time_ns(), 0, 7, 0)
+    monkeypatch.setattr(FoamFile, "_stat", lambda self: stat)
+
+    d = FoamFile(path)
+    assert d["key"] == "a"
+    path.write_text("key b;\n")
+    assert d["key"] == "b"
+
+    # Stats taken long enough after the last change are trusted
+    stat = (0, 0, 7, 0)
+    assert d["key"] == "b"
+    path.write_text("key c;\n")
+    assert d["key"] == "b"
+
+
+def test_memory_map(tmp_path: Path) -> None:
+    path = tmp_path / "U"
+    path.touch()
+
+    f = FoamFieldFile(path)
+    f["FoamFile"] = {"format": "binary", "class": "volVectorField"}
+    f.internal_field = np.arange(30, dtype=float).reshape(10, 3)
+    f["boundaryField"] = {}
+    f[("boundaryField", "inlet")] = {"type": "zeroGradient"}
+
+    mapped = FoamFieldFile(path, memory_map=True)
+    assert mapped.boundary_field["inlet"].type == "zeroGradient"
+    U = mapped.internal_field
+    assert isinstance(U, np.ndarray)
+    assert U.shape == (10, 3)
+    assert U.tolist() == np.arange(30, dtype=float).reshape(10, 3).tolist()
+
+    # Arrays are not copied
+    with mapped:
+        assert np.shares_memory(
+            mapped.as_dict()["internalField"], mapped.internal_field
+        )
+
+    mapped.internal_field = np.zeros((2, 3))
+    assert U.tolist() == np.arange(30, dtype=float).reshape(10, 3).tolist()
+    assert mapped.internal_field.tolist() == [[0, 0, 0], [0, 0, 0]]
+    assert f.internal_field.tolist() == [[0, 0, 0], [0, 0, 0]]
+    assert f.boundary_field["inlet"].type == "zeroGradient"
+
+    # Writes through an instance that does not map the file must not
+    # truncate it under the arrays mapped by another one
+    U = mapped.internal_field
+    f.internal_field = np.ones((4, 3))
+    assert U.tolist() == [[0, 0, 0], [0, 0, 0]]
+    assert mapped.internal_field.tolist() == [[1, 1, 1]] * 4
+
+
+def test_memory_map_replace(tmp_path: Path) -> None:
+    target = tmp_path / "target"
+    target.write_text("a 1;\n")
+    target.chmod(0o640)
+    link = tmp_path / "link"
+    link.symlink_to(target)
+
+    f = FoamFile(link, memory_map=True)
+    f["a"] = 2
+    assert link.is_symlink()
+    assert FoamFile(target)["a"] == 2
+    assert target.stat().st_mode & 0o777 == 0o640
+
+    umask = os.umask(0o022)
+    try:
+        path = tmp_path / "new"
+        FoamFile(path, memory_map=True)._replace(b"a 1;\n")
+        assert path.stat().st_mode & 0o777 == 0o644
+    finally:
+        os.umask(umask)
+
+
+def test_write_precision(tmp_path: Path) -> None:
+    path = tmp_path / "p"
+    path.touch()
+
+    f = FoamFieldFile(path, write_precision=4)
+    f.internal_field = np.array([1 / 3, 2 / 3, 1e-7, 1.0])
+    f["pi"] = 3.141592653589793
+    f["thirds"] = np.array([[1 / 3, 2 / 3]])
+    contents = path.read_text()
+    assert "internalField nonuniform List<scalar> 4(0.3333 0.6667 1e-07 1)" in contents
+    assert "thirds ((0.3333 0.6667));" in contents
+    assert f["pi"] == 3.141592653589793
+
+
+def test_single_precision(tmp_path: Path) -> None:
+    path = tmp_path / "U"
+    path.touch()
+
+    f = FoamFieldFile(path)
+    f["FoamFile"] = {
+        "format": "binary",
+        "class": "volVectorField",
+        "arch": '"LSB;label=32;scalar=32"',
+    }
+    f.internal_field = np.arange(30, dtype=float).reshape(10, 3)
+    f["boundaryField"] = {"inlet": {"type": "fixedValue", "value": [[1, 2, 3]] * 4}}
+
+    contents = path.read_bytes()
+    assert (
+        b"internalField nonuniform List<vector> 10("
+        + np.arange(30, dtype=np.float32).tobytes()
+        + b")"
+        in contents
+    )
+
+    U = FoamFieldFile(path).internal_field
+    assert isinstance(U, np.ndarray)
+    assert U.dtype == np.float32
+    assert U.tolist() == np.arange(30, dtype=float).reshape(10, 3).tolist()
+    value = f.boundary_field["inlet"].value
+    assert isinstance(value, np.ndarray)
+    assert value.tolist() == [[1, 2, 3]] * 4
+
+
+def test_big_endian(tmp_path: Path) -> None:
+    path = tmp_path / "U"
+    path.touch()
+
+    f = FoamFieldFile(path)
+    f["FoamFile"] = {
+        "format": "binary",
+        "class": "volVectorField",
+        "arch": '"MSB;label=32;scalar=64"',
+    }
+    f.internal_field = np.arange(30, dtype=float).reshape(10, 3)
+    f["boundaryField"] = {"inlet": {"type": "fixedValue", "value": [[1, 2, 3]] * 4}}
+
+    contents = path.read_bytes()
+    assert (
+        b"internalField nonuniform List<vector> 10("
+        + np.arange(30, dtype=">f8").tobytes()
+        + b")"
+        in contents
+    )
+    assert (
+        b"value nonuniform List<vector> 4("
+        + np.array([1, 2, 3] * 4, dtype=">f8").tobytes()
+        + b")"
+        in contents
+    )
+
+    U = FoamFieldFile(path).internal_field
+    assert isinstance(U, np.ndarray)
+    assert U.tolist() == np.arange(30, dtype=float).reshape(10, 3).tolist()
+    value = FoamFieldFile(path).boundary_field["inlet"].value
+    assert isinstance(value, np.ndarray)
+    assert value.tolist() == [[1, 2, 3]] * 4
+
+
+def test_incremental_edits(tmp_path: Path) -> None:
+    path = tmp_path / "testDict"
+    path.write_text(
+        "FoamFile\n{\n    format ascii;\n}\n"
+        "a 1;\n"
+        "sub\n{\n    x 1;\n    inner { y 2; }\n}\n"
+        "field nonuniform List<scalar> 4(1 2 3 4);\n"
+    )
+
+    f = FoamFile(path)
+    with f:
+        f["a"] = [1, 2, 3]
+        f["b"] = "word"
+        f["sub", "inner", "z"] = {"k": 1, "m": {"n": "v"}}
+        del f["sub", "x"]
+        f["sub", "x"] = 2.5
+    del f["a"]
+    f["sub", "inner", "y"] = ("w1", "w2")
+
+    _, parsed = f._read()
+    fresh = Parsed(path.read_bytes())
+    assert list(parsed) == list(fresh)
+    for keywords in fresh:
+        start, _, end = fresh._parsed[keywords]
+        assert parsed._parsed[keywords][0] == start
+        assert parsed._parsed[keywords][2] == end
+    d = f.as_dict()
+    field = d.pop("field")
+    assert isinstance(field, np.ndarray)
+    assert field.tolist() == [1, 2, 3, 4]
+    assert d == {
+        "FoamFile": {"format": "ascii"},
+        "sub": {
+            "inner": {"y": ("w1", "w2"), "z": {"k": 1, "m": {"n": "v"}}},
+            "x": 2.5,
+        },
+        "b": "word",
+    }
+
+
+def test_assign_boundary_field(tmp_path: Path) -> None:
+    path = tmp_path / "U"
+    path.touch()
+
+    f = FoamFieldFile(path)
+    f["FoamFile"] = {"format": "binary", "class": "volVectorField"}
+    f["boundaryField"] = {
+        "inlet": {"type": "fixedValue", "value": np.ones((4, 3))},
+        "outlet": {"type": "zeroGradient"},
+    }
+
+    contents = path.read_bytes()
+    assert b"nonuniform List<vector> 4(" + np.ones((4, 3)).tobytes() in contents
+    assert f.boundary_field["outlet"].type == "zeroGradient"
+    inlet = f.boundary_field["inlet"].value
+    assert isinstance(inlet, np.ndarray)
+    assert inlet.tolist() == [[1, 1, 1]] * 4
+
+
+def test_gzip(tmp_path: Path) -> None:
+    path = tmp_path / "p.gz"
+    path.write_bytes(
+        gzip.compress(b"a 1;\ninternalField nonuniform List<scalar> 3(1 2 3);\n")
+        + gzip.compress(b"b 2;\nc word;\nd yes;\ne off;\n")
+        + gzip.compress(b"boundaryField { inlet { type fixedValue; } }\n")
+    )
+
+    f = FoamFieldFile(path)
+    assert f["a"] == 1
+    assert f["b"] == 2
+    assert f["c"] == "word"
+    assert f["d"] is True
+    assert f["e"] is False
+    assert f.boundary_field["inlet"].type == "fixedValue"
+
+    f["f"] = 3
+    assert gzip.decompress(path.read_bytes()).endswith(b"\nf 3;\n\n")
+    assert FoamFile(path).as_dict()["f"] == 3
+
+    compresslevel = FoamFile.compresslevel
+    try:
+        FoamFile.compresslevel = 1
+        f.internal_field = np.zeros(10000)
+    finally:
+        FoamFile.compresslevel = compresslevel
+    field = FoamFieldFile(path).internal_field
+    assert isinstance(field, np.ndarray)
+    assert field.tolist() == [0] * 10000
+
+
+def test_gzip_threads(tmp_path: Path, monkeypatch: pytest.MonkeyPatch) -> None:
+    monkeypatch.setattr("foamlib._files._io._GZIP_BLOCK_SIZE", 1000)
+    monkeypatch.setattr(FoamFile, "compression_threads", 4)
+
+    path = tmp_path / "p.gz"
+    path.touch()
+
+    f = FoamFieldFile(path)
+    f.internal_field = np.arange(10000, dtype=float)
+
+    contents = path.read_bytes()
+    assert contents.count(b"\x1f\x8b\x08") > 1
+    assert gzip.decompress(contents).startswith(b"\ninternalField nonuniform")
+    field = FoamFieldFile(path).internal_field
+    assert isinstance(field, np.ndarray)
+    assert field.tolist() == list(range(10000))
+
+
+def test_gzip_corrupt_size(tmp_path: Path) -> None:
+    # A corrupt trailer claiming a 4 GiB file must not be trusted to size
+    # the buffer
+    path = tmp_path / "p.gz"
+    contents = gzip.compress(b"a 1;\n")
+    path.write_bytes(contents[:-4] + (2**32 - 1).to_bytes(4, "little"))
+
+    tracemalloc.start()
+    try:
+        with pytest.raises(OSError):
+            FoamFile(path)["a"]
+        _, peak = tracemalloc.get_traced_memory()
+    finally:
+        tracemalloc.stop()
+    assert peak < 2**24
+
+
+def test_cache_dir(tmp_path: Path, monkeypatch: pytest.MonkeyPatch) -> None:
+    monkeypatch.setattr(FoamFile, "cache_dir", tmp_path / "cache")
+
+    path = tmp_path / "U"
+    path.write_text(
+        "FoamFile\n{\n    format ascii;\n}\n"
+        "internalField nonuniform List<vector> 2((1 2 3) (4 5 6));\n"
+        "boundaryField\n{\n    inlet\n    {\n        type zeroGradient;\n    }\n}\n"
+    )
+
+    # Files modified just now are not cached
+    assert FoamFieldFile(path).boundary_field["inlet"].type == "zeroGradient"
+    assert not (tmp_path / "cache").exists()
+
+    os.utime(path, (0, 0))
+    assert FoamFieldFile(path).boundary_field["inlet"].type == "zeroGradient"
+    assert len(list((tmp_path / "cache").iterdir())) == 1
+
+    def fail(*args: object, **kwargs: object) -> None:
+        raise AssertionError("file parsed again")
+
+    with monkeypatch.context() as m:
+        m.setattr(Parsed, "__init__", fail)
+        f = FoamFieldFile(path)
+        assert f.boundary_field["inlet"].type == "zeroGradient"
+        U = f.internal_field
+        assert isinstance(U, np.ndarray)
+        assert not U.flags.writeable
+        assert U.tolist() == [[1, 2, 3], [4, 5, 6]]
+
+    f.internal_field = np.zeros((3, 3))
+    U = FoamFieldFile(path).internal_field
+    assert isinstance(U, np.ndarray)
+    assert U.tolist() == [[0, 0, 0]] * 3
+    assert len(list((tmp_path / "cache").iterdir())) == 1
+
+    os.utime(path, (0, 0))
+    U = FoamFieldFile(path).internal_field
+    assert isinstance(U, np.ndarray)
+    assert U.tolist() == [[0, 0, 0]] * 3
+    assert len(list((tmp_path / "cache").iterdir())) == 2
+
+
+class _Exploit:
+    def __reduce__(self) -> Tuple[Any, Tuple[str]]:
+        return (os.mkdir, (str(_Exploit.path),))
+
+    path = Path()
+
+
+def test_cache_dir_untrusted(tmp_path: Path, monkeypatch: pytest.MonkeyPatch) -> None:
+    monkeypatch.setattr(FoamFile, "cache_dir", tmp_path / "cache")
+
+    path = tmp_path / "testDict"
+    path.write_text("a (1 2 3);\nb nonuniform List<scalar> 0();\n")
+    os.utime(path, (0, 0))
+
+    assert FoamFile(path)["a"] == [1, 2, 3]
+    (entry,) = (tmp_path / "cache").iterdir()
+    b = FoamFile(path)["b"]
+    assert isinstance(b, np.ndarray)
+    assert b.shape == (0,)
+
+    # Anything other than a parsed file is never loaded from the cache
+    _Exploit.path = tmp_path / "pwned"
+    (entry / "parsed.pickle").write_bytes(pickle.dumps(_Exploit()))
+    assert FoamFile(path)["a"] == [1, 2, 3]
+    assert not _Exploit.path.exists()
 
 
 @pytest.fixture
@@ -130,9 +513,9 @@ def test_internal_field(pitz: FoamCase) -> None:
     pitz.run()
 
     p = pitz[-1]["p"].internal_field
-    assert isinstance(p, Sequence)
+    assert isinstance(p, np.ndarray)
     U = pitz[-1]["U"].internal_field
-    assert isinstance(U, Sequence)
+    assert isinstance(U, np.ndarray)
     size = len(p)
     assert len(U) == size
 
@@ -146,7 +529,7 @@ def test_internal_field(pitz: FoamCase) -> None:
 
     assert pitz[0]["p"].internal_field == pytest.approx(p_arr)
     U = pitz[0]["U"].internal_field
-    assert isinstance(U, Sequence)
+    assert isinstance(U, np.ndarray)
     for u, u_arr in zip(U, U_arr):
         assert u == pytest.approx(u_arr)
 
@@ -158,7 +541,7 @@ def test_internal_field(pitz: FoamCase) -> None:
 
     assert pitz[0]["p"].internal_field == pytest.approx(p_arr)
     U = pitz[0]["U"].internal_field
-    assert isinstance(U, Sequence)
+    assert isinstance(U, np.ndarray)
     for u, u_arr in zip(U, U_arr):
         assert u == pytest.approx(u_arr)
 
@@ -179,10 +562,10 @@ def test_binary_field(pitz: FoamCase) -> None:
     pitz.run()
 
     p_bin = pitz[-1]["p"].internal_field
-    assert isinstance(p_bin, Sequence)
+    assert isinstance(p_bin, np.ndarray)
     U_bin = pitz[-1]["U"].internal_field
-    assert isinstance(U_bin, Sequence)
-    assert isinstance(U_bin[0], Sequence)
+    assert isinstance(U_bin, np.ndarray)
+    assert isinstance(U_bin[0], np.ndarray)
     assert len(U_bin[0]) == 3
     size = len(p_bin)
     assert len(U_bin) == size
@@ -197,7 +580,7 @@ def test_binary_field(pitz: FoamCase) -> None:
 
     assert pitz[0]["p"].internal_field == pytest.approx(p_arr)
     U = pitz[0]["U"].internal_field
-    assert isinstance(U, Sequence)
+    assert isinstance(U, np.ndarray)
     for u, u_arr in zip(U, U_arr):
         assert u == pytest.approx(u_arr)
 
@@ -210,10 +593,10 @@ def test_compressed_field(pitz: FoamCase) -> None:
     pitz.run()
 
     p_bin = pitz[-1]["p"].internal_field
-    assert isinstance(p_bin, Sequence)
+    assert isinstance(p_bin, np.ndarray)
     U_bin = pitz[-1]["U"].internal_field
-    assert isinstance(U_bin, Sequence)
-    assert isinstance(U_bin[0], Sequence)
+    assert isinstance(U_bin, np.ndarray)
+    assert isinstance(U_bin[0], np.ndarray)
     assert len(U_bin[0]) == 3
     size = len(p_bin)
     assert len(U_bin) == size
@@ -228,7 +611,7 @@ def test_compressed_field(pitz: FoamCase) -> None:
 
     assert pitz[0]["p"].internal_field == pytest.approx(p_arr)
     U = pitz[0]["U"].internal_field
-    assert isinstance(U, Sequence)
+    assert isinstance(U, np.ndarray)
     for u, u_arr in zip(U, U_arr):
         assert u == pytest.approx(u_arr)
 
@@ -1,4 +1,10 @@
+from typing import Any
+
+import numpy as np
+import pytest
 from foamlib import FoamFile
+from foamlib._files import _parsing
+from foamlib._files._fast_parsing import ParseError, parse
 from foamlib._files._parsing import Parsed
 
 
@@ -16,7 +22,9 @@ def test_parse_value() -> None:
     assert Parsed(b"uniform 1.0e-3")[""] == 1.0e-3
     assert Parsed(b"(1.0 2.0 3.0)")[""] == [1.0, 2.0, 3.0]
     assert Parsed(b"uniform (1 2 3)")[""] == [1, 2, 3]
-    assert Parsed(b"nonuniform List<scalar> 2(1 2)")[""] == [1, 2]
+    field = Parsed(b"nonuniform List<scalar> 2(1 2)")[""]
+    assert isinstance(field, np.ndarray)
+    assert field.tolist() == [1, 2]
     assert Parsed(b"nonuniform List<scalar> 2{1}")[""] == [1, 1]
     assert Parsed(b"3(1 2 3)")[""] == [1, 2, 3]
     assert Parsed(b"2((1 2 3) (4 5 6))")[""] == [
@@ -27,20 +35,28 @@ def test_parse_value() -> None:
         [1, 2, 3],
         [1, 2, 3],
     ]
-    assert Parsed(b"nonuniform List<vector> 2((1 2 3) (4 5 6))")[""] == [
-        [1, 2, 3],
-        [4, 5, 6],
-    ]
+    field = Parsed(b"nonuniform List<vector> 2((1 2 3) (4 5 6))")[""]
+    assert isinstance(field, np.ndarray)
+    assert field.shape == (2, 3)
+    assert field.tolist() == [[1, 2, 3], [4, 5, 6]]
+    field = Parsed(b"nonuniform List<vector> 0()")[""]
+    assert isinstance(field, np.ndarray)
+    assert field.shape == (0, 3)
     assert Parsed(b"nonuniform List<vector> 2{(1 2 3)}")[""] == [
         [1, 2, 3],
         [1, 2, 3],
     ]
-    assert Parsed(
+    field = Parsed(
         b"nonuniform List<scalar> 2(\x00\x00\x00\x00\x00\x00\xf0?\x00\x00\x00\x00\x00\x00\x00@)"
-    )[""] == [1, 2]
-    assert Parsed(
+    )[""]
+    assert isinstance(field, np.ndarray)
+    assert field.tolist() == [1, 2]
+    field = Parsed(
         b"nonuniform List<vector> 2(\x00\x00\x00\x00\x00\x00\xf0?\x00\x00\x00\x00\x00\x00\x00@\x00\x00\x00\x00\x00\x00\x08@\x00\x00\x00\x00\x00\x00\x10@\x00\x00\x00\x00\x00\x00\x14@\x00\x00\x00\x00\x00\x00\x18@)"
-    )[""] == [[1, 2, 3], [4, 5, 6]]
+    )[""]
+    assert isinstance(field, np.ndarray)
+    assert field.shape == (2, 3)
+    assert field.tolist() == [[1, 2, 3], [4, 5, 6]]
     assert Parsed(b"[1 1 -2 0 0 0 0]")[""] == FoamFile.DimensionSet(
         mass=1, length=1, time=-2
     )
@@ -65,3 +81,196 @@ def test_parse_value() -> None:
         {"d": {"e": "g"}},
     ]
     assert Parsed(b"(a (0 1 2); b {})")[""] == [{"a": [0, 1, 2]}, {"b": {}}]
+
+
+def test_parse_file() -> None:
+    contents = b"""/*--------------------------------*- C++ -*----------------------------------*\\
+  =========                 |
+  \\\\      /  F ield         | OpenFOAM: The Open Source CFD Toolbox
+\\*---------------------------------------------------------------------------*/
+FoamFile
+{
+    version     2.0;
+    format      ascii;
+    class       volVectorField;
+    object      U;
+}
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+#include "initialConditions"
+
+dimensions      [0 1 -1 0 0 0 0];
+
+internalField   nonuniform List<vector> 2((1 2 3) (4 5 6));
+
+boundaryField
+{
+    inlet
+    {
+        type            fixedValue;
+        value           uniform (10 0 0); // comment
+    }
+    "(outlet|walls)"
+    {
+        type            zeroGradient;
+    }
+    /* comment */
+    frontAndBack
+    {
+        type            empty;
+    }
+}
+
+// ************************************************************************* //
+"""
+
+    fast = parse(contents)
+    slow = Parsed._parse_with_pyparsing(contents)
+    assert fast.keys() == slow.keys()
+    for keywords, (start, data, end) in fast.items():
+        slow_start, slow_data, slow_end = slow[keywords]
+        assert isinstance(data, np.ndarray) == isinstance(slow_data, np.ndarray)
+        if isinstance(data, np.ndarray):
+            data = data.tolist()
+            slow_data = slow_data.tolist()  # type: ignore [union-attr]
+        assert (start, data, end) == (slow_start, slow_data, slow_end)
+
+
+def test_parse_with_pyparsing(monkeypatch: pytest.MonkeyPatch) -> None:
+    def fail(*args: Any, **kwargs: Any) -> Any:
+        raise ParseError
+
+    monkeypatch.setattr(_parsing, "parse", fail)
+
+    field = Parsed(b"nonuniform List<vector> 2((1 2 3) (4 5 6))")[""]
+    assert isinstance(field, np.ndarray)
+    assert not field.flags.writeable
+    assert field.tolist() == [[1, 2, 3], [4, 5, 6]]
+
+    header = (
+        b"FoamFile { version 2.0; format binary; class volVectorField;"
+        b' arch "LSB;label=32;scalar=32"; }\n'
+    )
+    values = np.arange(6, dtype=np.float32)
+    parsed = Parsed(
+        header
+        + b"internalField nonuniform List<vector> 2("
+        + values.tobytes()
+        + b");\n"
+    )
+    field = parsed["internalField"]
+    assert isinstance(field, np.ndarray)
+    assert field.dtype == np.float32
+    assert field.tolist() == [[0, 1, 2], [3, 4, 5]]
+
+
+def test_parse_unbalanced_words() -> None:
+    assert Parsed(b"fields (p U);")["fields"] == ["p", "U"]
+    assert Parsed(b"div(phi,U) Gauss linear;")["div(phi,U)"] == ("Gauss", "linear")
+    assert Parsed(b"inGroups List<word> 1(wall);")["inGroups"] == ["wall"]
+
+
+def test_parse_directives() -> None:
+    contents = b'a 1;\n#includeEtc "caseDicts/setConstraintTypes"\nb 2;\n'
+    assert parse(contents).keys() == {("a",), ("b",)}
+
+    with pytest.raises(ParseError):
+        parse(b"#inputMode merge\nb 2;\n")
+    with pytest.raises(ParseError):
+        parse(b"a { #remove b; }\n")
+
+
+def test_parse_lazy() -> None:
+    contents = b"""
+    FoamFile { version 2.0; format ascii; class volVectorField; }
+    dimensions [0 1 -1 0 0 0 0];
+    internalField nonuniform List<vector> 2((1 2 3) (4 5 6)); // ;
+    boundaryField
+    {
+        inlet { type fixedValue; value uniform (1 0 0); }
+        outlet { type "zero;Gradient"; /* } */ }
+    }
+    """
+    eager = Parsed(contents)
+    lazy = Parsed(contents, lazy=True)
+
+    assert list(lazy) == list(eager)
+    for keywords in eager:
+        assert lazy.entry_location(keywords) == eager.entry_location(keywords)
+
+    assert lazy["FoamFile", "class"] == "volVectorField"
+    assert lazy["boundaryField", "outlet", "type"] == '"zero;Gradient"'
+    assert lazy.as_dict(("boundaryField",)) == eager.as_dict(("boundaryField",))
+    field = lazy["internalField"]
+    assert isinstance(field, np.ndarray)
+    assert field.tolist() == [[1, 2, 3], [4, 5, 6]]
+
+
+def test_parse_lazy_binary() -> None:
+    # The raw values contain the bytes of ';', ')' and '}'
+    contents = (
+        b"FoamFile { version 2.0; format binary; class volScalarField; }\n"
+        b"internalField nonuniform List<scalar> 2("
+        b";)};\x00\x00\xf0?\x00\x00\x00\x00\x00\x00\x00@);\n"
+        b"boundaryField { wall { type zeroGradient; } }\n"
+    )
+    lazy = Parsed(contents, lazy=True)
+
+    assert list(lazy) == list(Parsed(contents))
+    assert lazy["boundaryField", "wall", "type"] == "zeroGradient"
+    field = lazy["internalField"]
+    assert isinstance(field, np.ndarray)
+    assert field[1] == 2
+
+
+def test_parse_binary_labels() -> None:
+    header = b"FoamFile { version 2.0; format binary; class labelList; }\n"
+    owner = np.array([0, 1, 1, 2], dtype=np.int32)
+    for lazy in (False, True):
+        parsed = Parsed(header + b"4(" + owner.tobytes() + b")\n", lazy=lazy)
+        labels = parsed[""]
+        assert isinstance(labels, np.ndarray)
+        assert labels.dtype == np.int32
+        assert labels.tolist() == [0, 1, 1, 2]
+
+    header = (
+        b"FoamFile { version 2.0; format binary; class faceCompactList;"
+        b' arch "LSB;label=64;scalar=64"; }\n'
+    )
+    offsets = np.array([0, 3, 7], dtype=np.int64)
+    faces = np.array([0, 1, 2, 1, 2, 3, 4], dtype=np.int64)
+    parsed = Parsed(
+        header + b"3(" + offsets.tobytes() + b")\n7(" + faces.tobytes() + b")\n"
+    )
+    value = parsed[""]
+    assert isinstance(value, tuple)
+    assert [v.dtype for v in value] == [np.int64, np.int64]
+    assert value[0].tolist() == [0, 3, 7]
+    assert value[1].tolist() == [0, 1, 2, 1, 2, 3, 4]
+
+    header = (
+        b"FoamFile { version 2.0; format binary; class labelList;"
+        b' arch "MSB;label=32;scalar=64"; }\n'
+    )
+    owner = np.array([0, 1, 1, 2], dtype=">i4")
+    labels = Parsed(header + b"4(" + owner.tobytes() + b")\n")[""]
+    assert isinstance(labels, np.ndarray)
+    assert labels.tolist() == [0, 1, 1, 2]
+
+    header = b"FoamFile { version 2.0; format binary; class vectorField; }\n"
+    points = np.array([0, 0, 0, 1, 0, 0], dtype=float)
+    value = Parsed(header + b"2(" + points.tobytes() + b")\n")[""]
+    assert isinstance(value, np.ndarray)
+    assert value.tolist() == [[0, 0, 0], [1, 0, 0]]
+
+    header = b"FoamFile { version 2.0; format binary; class dictionary; }\n"
+    for lazy in (False, True):
+        parsed = Parsed(
+            header
+            + b"cells List<label> 2("
+            + np.array([41, 59], dtype=np.int32).tobytes()
+            + b");\nflip List<bool> 3(\x01\x00\x01);\n",
+            lazy=lazy,
+        )
+        assert parsed["cells"].tolist() == [41, 59]  # type: ignore [union-attr]
+        assert parsed["flip"].tolist() == [True, False, True]  # type: ignore [union-attr]
@@ -0,0 +1,233 @@
+import gzip
+from pathlib import Path
+from typing import Any, Callable, Dict, List, Optional
+
+import numpy as np
+import pytest
+from foamlib import FoamCase, FoamMesh
+
+
+def _row_mesh(nx: int) -> Dict[str, Any]:
+    # nx unit cubes in a row along x
+    def p(i: int, j: int, k: int) -> int:
+        return i + (nx + 1) * (j + 2 * k)
+
+    points = [[i, j, k] for k in range(2) for j in range(2) for i in range(nx + 1)]
+
+    faces: List[List[int]] = []
+    owner: List[int] = []
+    neighbour: List[int] = []
+    for i in range(nx - 1):
+        faces.append([p(i + 1, 0, 0), p(i + 1, 1, 0), p(i + 1, 1, 1), p(i + 1, 0, 1)])
+        owner.append(i)
+        neighbour.append(i + 1)
+
+    faces.append([p(0, 0, 0), p(0, 0, 1), p(0, 1, 1), p(0, 1, 0)])
+    owner.append(0)
+    faces.append([p(nx, 0, 0), p(nx, 1, 0), p(nx, 1, 1), p(nx, 0, 1)])
+    owner.append(nx - 1)
+    for i in range(nx):
+        faces.append([p(i, 0, 0), p(i + 1, 0, 0), p(i + 1, 0, 1), p(i, 0, 1)])
+        faces.append([p(i, 1, 0), p(i, 1, 1), p(i + 1, 1, 1), p(i + 1, 1, 0)])
+        faces.append([p(i, 0, 0), p(i, 1, 0), p(i + 1, 1, 0), p(i + 1, 0, 0)])
+        faces.append([p(i, 0, 1), p(i + 1, 0, 1), p(i + 1, 1, 1), p(i, 1, 1)])
+        owner += [i] * 4
+
+    return {
+        "points": points,
+        "faces": faces,
+        "owner": owner,
+        "neighbour": neighbour,
+        "boundary": {
+            "ends": {"type": "patch", "nFaces": 2, "startFace": nx - 1},
+            "walls": {"type": "wall", "nFaces": 4 * nx, "startFace": nx + 1},
+        },
+    }
+
+
+def _header(cls: str, *, binary: bool) -> bytes:
+    return (
+        b"FoamFile\n{\n    version 2.0;\n"
+        + (b"    format binary;\n" if binary else b"    format ascii;\n")
+        + f"    class {cls};\n}}\n".encode()
+    )
+
+
+def write_mesh(
+    path: Path,
+    nx: int,
+    *,
+    binary: bool = False,
+    gz: bool = False,
+    warp: Optional[Callable[[List[float]], List[float]]] = None,
+) -> None:
+    mesh = _row_mesh(nx)
+    if warp is not None:
+        mesh["points"] = [warp(p) for p in mesh["points"]]
+    path.mkdir(parents=True)
+
+    def write(name: str, contents: bytes) -> None:
+        if gz:
+            (path / f"{name}.gz").write_bytes(gzip.compress(contents))
+        else:
+            (path / name).write_bytes(contents)
+
+    points = np.array(mesh["points"], dtype=float)
+    if binary:
+        write(
+            "points",
+            _header("vectorField", binary=True)
+            + f"{len(points)}\n(".encode()
+            + points.tobytes()
+            + b")\n",
+        )
+        offsets = np.array(
+            [0, *np.cumsum([len(f) for f in mesh["faces"]]).tolist()], dtype=np.int32
+        )
+        labels = np.array([i for f in mesh["faces"] for i in f], dtype=np.int32)
+        write(
+            "faces",
+            _header("faceCompactList", binary=True)
+            + f"{len(offsets)}\n(".encode()
+            + offsets.tobytes()
+            + f")\n{len(labels)}\n(".encode()
+            + labels.tobytes()
+            + b")\n",
+        )
+        for name in ("owner", "neighbour"):
+            write(
+                name,
+                _header("labelList", binary=True)
+                + f"{len(mesh[name])}\n(".encode()
+                + np.array(mesh[name], dtype=np.int32).tobytes()
+                + b")\n",
+            )
+    else:
+        write(
+            "points",
+            _header("vectorField", binary=False)
+            + f"{len(points)}\n(\n".encode()
+            + b"".join(f"({x} {y} {z})\n".encode() for x, y, z in mesh["points"])
+            + b")\n",
+        )
+        write(
+            "faces",
+            _header("faceList", binary=False)
+            + f"{len(mesh['faces'])}\n(\n".encode()
+            + b"".join(
+                f"{len(f)}({' '.join(map(str, f))})\n".encode() for f in mesh["faces"]
+            )
+            + b")\n",
+        )
+        for name in ("owner", "neighbour"):
+            write(
+                name,
+                _header("labelList", binary=False)
+                + f"{len(mesh[name])}\n(\n".encode()
+                + b"".join(f"{i}\n".encode() for i in mesh[name])
+                + b")\n",
+            )
+
+    write(
+        "boundary",
+        _header("polyBoundaryMesh", binary=False)
+        + b"2\n(\n"
+        + b"".join(
+            f"{name}\n{{\n type {p['type']};\n nFaces {p['nFaces']};\n"
+            f" startFace {p['startFace']};\n}}\n".encode()
+            for name, p in mesh["boundary"].items()
+        )
+        + b")\n",
+    )
+
+
+@pytest.mark.parametrize(
+    ("binary", "gz"), [(False, False), (True, False), (False, True), (True, True)]
+)
+def test_mesh(tmp_path: Path, binary: bool, gz: bool) -> None:
+    write_mesh(tmp_path / "constant" / "polyMesh", 3, binary=binary, gz=gz)
+    expected = _row_mesh(3)
+
+    mesh = FoamCase(tmp_path).mesh
+    assert isinstance(mesh, FoamMesh)
+
+    assert mesh.n_points == 16
+    assert mesh.n_faces == 16
+    assert mesh.n_internal_faces == 2
+    assert mesh.n_cells == 3
+
+    assert mesh.points.shape == (16, 3)
+    assert mesh.points.tolist() == expected["points"]
+    assert mesh.owner.tolist() == expected["owner"]
+    assert mesh.neighbour.tolist() == expected["neighbour"]
+    assert mesh.face_offsets.tolist() == list(range(0, 4 * 16 + 1, 4))
+    assert mesh.face_points.tolist() == [i for f in expected["faces"] for i in f]
+    assert mesh.boundary == expected["boundary"]
+
+    assert not mesh.points.flags.writeable
+    assert not mesh.face_points.flags.writeable
+
+
+def test_geometry(tmp_path: Path) -> None:
+    write_mesh(tmp_path / "polyMesh", 3)
+    mesh = FoamMesh(tmp_path / "polyMesh")
+
+    assert mesh.face_centres.shape == (16, 3)
+    assert np.allclose(mesh.face_centres[:2], [[1, 0.5, 0.5], [2, 0.5, 0.5]])
+    assert np.allclose(
+        mesh.face_areas[:8],
+        [
+            [1, 0, 0],
+            [1, 0, 0],
+            [-1, 0, 0],
+            [1, 0, 0],
+            [0, -1, 0],
+            [0, 1, 0],
+            [0, 0, -1],
+            [0, 0, 1],
+        ],
+    )
+
+    assert mesh.cell_centres.shape == (3, 3)
+    assert np.allclose(mesh.cell_centres, [[i + 0.5, 0.5, 0.5] for i in range(3)])
+    assert np.allclose(mesh.cell_volumes, [1, 1, 1])
+
+    assert not mesh.cell_centres.flags.writeable
+    assert not mesh.cell_volumes.flags.writeable
+
+
+def test_geometry_skewed(tmp_path: Path) -> None:
+    # A single cell with a trapezoidal cross section (1 wide at z=0, 2 wide
+    # at z=1). All faces are planar, so the results are exact, unlike the
+    # averages of the points
+    write_mesh(tmp_path / "polyMesh", 1, warp=lambda p: [p[0] * (1 + p[2]), *p[1:]])
+    mesh = FoamMesh(tmp_path / "polyMesh")
+
+    assert np.allclose(mesh.cell_volumes, [1.5])
+    assert np.allclose(mesh.cell_centres, [[7 / 9, 0.5, 5 / 9]])
+    # Faces: ends (x=0 and x=1+z), then walls (y=0, y=1, z=0 and z=1)
+    assert np.allclose(mesh.face_centres[1], [1.5, 0.5, 0.5])
+    assert np.allclose(mesh.face_areas[1], [1, 0, -1])
+    assert np.allclose(mesh.face_centres[2], [7 / 9, 0, 5 / 9])
+    assert np.allclose(mesh.face_areas[2], [0, -1.5, 0])
+
+
+def test_geometry_warped(tmp_path: Path) -> None:
+    # Two cells, with one corner of the face between them moved along x so
+    # that the face is not planar (the outer faces stay planar)
+    def warp(p: List[float]) -> List[float]:
+        return [p[0] + 0.3, *p[1:]] if p == [1, 1, 1] else p
+
+    write_mesh(tmp_path / "polyMesh", 2, warp=warp)
+    mesh = FoamMesh(tmp_path / "polyMesh")
+
+    # The area vector of a quadrilateral, planar or not, is half the cross
+    # product of its diagonals
+    p = np.array([[1, 0, 0], [1, 1, 0], [1.3, 1, 1], [1, 0, 1]])
+    assert np.allclose(mesh.face_areas[0], 0.5 * np.cross(p[2] - p[0], p[3] - p[1]))
+
+    # Same as the volumes bounded by the bilinear surface x = 1 + 0.3*y*z
+    # through the corners of the face
+    assert np.allclose(mesh.cell_volumes, [1.075, 0.925])
+    assert mesh.cell_centres[0, 0] > 0.5
+    assert mesh.cell_centres[1, 0] > 1.5